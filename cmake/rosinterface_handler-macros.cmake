@@ -1,4 +1,11 @@
 
+# Generate all .rosif files of a package in one Python process instead of one process per file
+option(ROSINTERFACE_HANDLER_BATCH_GENERATION "Generate all interface files of a package in one Python process" OFF)
+# Print the time the generator spends in every stage (executing the .rosif, generating the cfg, headers and python)
+option(ROSINTERFACE_HANDLER_PROFILE_GENERATION "Print how long generating every interface takes" OFF)
+# Precompile the headers all generated interfaces include (see rosinterface_handler_precompile_headers())
+option(ROSINTERFACE_HANDLER_PRECOMPILED_HEADERS "Precompile the headers included by generated interfaces" OFF)
+
 macro(generate_ros_interface_files)
     set(CFG_FILES "${ARGN}")
     set(ROSINTERFACE_HANDLER_ROOT_DIR "${ROSINTERFACE_HANDLER_CMAKE_DIR}/..")
@@ -17,8 +24,16 @@ macro(generate_ros_interface_files)
     if(diagnostic_updater_FOUND_CATKIN_PROJECT)
         add_definitions(-DDIAGNOSTIC_UPDATER_FOUND)
     endif()
+    if(message_filters_FOUND_CATKIN_PROJECT AND diagnostic_updater_FOUND_CATKIN_PROJECT AND
+            "${rosinterface_handler_LIBRARIES}" MATCHES "rosinterface_handler_templates")
+        # rosinterface_handler was built with the precompiled subscriber templates (see extern_templates.hpp)
+        add_definitions(-DROSINTERFACE_HANDLER_EXTERN_TEMPLATES)
+    endif()
 
     set(_autogen "")
+    set(_batch_inputs "")
+    set(_batch_depends "")
+    set(_batch_byproducts "")
     foreach (_cfg ${CFG_FILES})
         # Construct the path to the .cfg file
         set(_input ${_cfg})
@@ -32,13 +47,24 @@ macro(generate_ros_interface_files)
             set(geninterface_build_files
                     ${ROSINTERFACE_HANDLER_ROOT_DIR}/templates/ConfigType.h.template
                     ${ROSINTERFACE_HANDLER_ROOT_DIR}/templates/Interface.h.template
+                    ${ROSINTERFACE_HANDLER_ROOT_DIR}/templates/Interface-inl.h.template
+                    ${ROSINTERFACE_HANDLER_ROOT_DIR}/templates/InterfaceFwd.h.template
+                    ${ROSINTERFACE_HANDLER_ROOT_DIR}/templates/Parameters.h.template
                     )
 
             # Define output files
             get_filename_component(_cfgonly ${_cfg} NAME_WE)
             set(_output_cfg ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_SHARE_DESTINATION}/cfg/${_cfgonly}.cfg)
-            set(_output_cpp ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}/${_cfgonly}Interface.h)
+            set(_output_cpp
+                    ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}/${_cfgonly}Interface.h
+                    ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}/${_cfgonly}Interface-inl.h
+                    ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}/${_cfgonly}InterfaceFwd.h
+                    ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}/${_cfgonly}Parameters.h
+                    )
             set(_output_py ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_PYTHON_DESTINATION}/interface/${_cfgonly}Interface.py)
+            # The generator only rewrites files whose content changed, so that unchanged headers do not trigger a
+            # rebuild. The stamp is written on every run and tells the build system that the generator ran.
+            set(_output_stamp ${CMAKE_CURRENT_BINARY_DIR}/rosinterface_handler/${_cfgonly}.stamp)
 
             # We need to explicitly add the devel space to the PYTHONPATH
             # since it might contain dynamic_reconfigure or Python code of the current package.
@@ -64,17 +90,36 @@ macro(generate_ros_interface_files)
                     ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_SHARE_DESTINATION}
                     ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}
                     ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_PYTHON_DESTINATION}
+                    --stamp=${_output_stamp}
                     )
+            if(ROSINTERFACE_HANDLER_PROFILE_GENERATION)
+                list(APPEND _cmd --profile)
+            endif()
 
-            add_custom_command(OUTPUT
-                    ${_output_cpp} ${_output_cfg} ${_output_py}
-                    COMMAND ${_cmd}
-                    DEPENDS ${_input} ${geninterface_build_files}
-                    COMMENT "Generating interface files from ${_cfgonly}"
-                    )
+            # Specialized build: parameters listed in ${ROSINTERFACE_SPECIALIZATION_DIR}/<name>.yaml become constants
+            set(_specialization "")
+            if(ROSINTERFACE_SPECIALIZATION_DIR AND EXISTS "${ROSINTERFACE_SPECIALIZATION_DIR}/${_cfgonly}.yaml")
+                set(_specialization "${ROSINTERFACE_SPECIALIZATION_DIR}/${_cfgonly}.yaml")
+                list(APPEND _cmd ${_specialization})
+                message(STATUS "Specializing interface ${_cfgonly} with ${_specialization}")
+            endif()
+
+            if(ROSINTERFACE_HANDLER_BATCH_GENERATION)
+                # generated together after the loop
+                list(APPEND _batch_inputs ${_input})
+                list(APPEND _batch_depends ${_input} ${_specialization})
+                list(APPEND _batch_byproducts ${_output_stamp} ${_output_cpp} ${_output_cfg} ${_output_py})
+            else()
+                add_custom_command(OUTPUT ${_output_stamp}
+                        BYPRODUCTS ${_output_cpp} ${_output_cfg} ${_output_py}
+                        COMMAND ${_cmd}
+                        DEPENDS ${_input} ${geninterface_build_files} ${_specialization}
+                        COMMENT "Generating interface files from ${_cfgonly}"
+                        )
+                list(APPEND ${PROJECT_NAME}_interfaces_generated ${_output_stamp})
+            endif()
 
             list(APPEND ${PROJECT_NAME}_LOCAL_CFG_FILES "${_output_cfg}")
-            list(APPEND ${PROJECT_NAME}_interfaces_generated ${_output_cpp} ${_output_cfg} ${_output_py})
 
             # make file show up in ides
             STRING(REGEX REPLACE "/" "-" IDE_TARGET_NAME ${PROJECT_NAME}-show-cfg-${_cfgonly})
@@ -94,6 +139,53 @@ macro(generate_ros_interface_files)
 
     endforeach (_cfg)
 
+    if(_batch_inputs)
+        # One command for all files. The generator skips every file whose stamp is newer than its dependencies,
+        # so only the changed files are generated again.
+        set(_output_batch_stamp ${CMAKE_CURRENT_BINARY_DIR}/rosinterface_handler/batch.stamp)
+        set(_batch_cmd
+                ${CATKIN_ENV}
+                ${_CUSTOM_PYTHONPATH_ENV}
+                ${PYTHON_EXECUTABLE} -m rosinterface_handler.batch_generator
+                ${ROSINTERFACE_HANDLER_ROOT_DIR}
+                ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_SHARE_DESTINATION}
+                ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_INCLUDE_DESTINATION}
+                ${CATKIN_DEVEL_PREFIX}/${CATKIN_PACKAGE_PYTHON_DESTINATION}
+                --stamp-dir=${CMAKE_CURRENT_BINARY_DIR}/rosinterface_handler
+                --cache-dir=${CMAKE_CURRENT_BINARY_DIR}/rosinterface_handler/models
+                )
+        if(ROSINTERFACE_HANDLER_PROFILE_GENERATION)
+            list(APPEND _batch_cmd --profile)
+        endif()
+        if(ROSINTERFACE_SPECIALIZATION_DIR)
+            list(APPEND _batch_cmd --specialization-dir=${ROSINTERFACE_SPECIALIZATION_DIR})
+        endif()
+        add_custom_command(OUTPUT ${_output_batch_stamp}
+                BYPRODUCTS ${_batch_byproducts}
+                COMMAND ${_batch_cmd} ${_batch_inputs}
+                COMMAND ${CMAKE_COMMAND} -E touch ${_output_batch_stamp}
+                DEPENDS ${_batch_depends} ${geninterface_build_files}
+                COMMENT "Generating interface files of ${PROJECT_NAME}"
+                )
+        list(APPEND ${PROJECT_NAME}_interfaces_generated ${_output_batch_stamp})
+    endif()
+
+    # Headers that are common to all interfaces, precompiled by rosinterface_handler_precompile_headers(). Only
+    # headers that do not change with the .rosif files are precompiled, otherwise the pch would be rebuilt all the time.
+    set(${PROJECT_NAME}_interface_pch_headers
+            <ros/node_handle.h>
+            <ros/param.h>
+            <rosinterface_handler/console_bridge_compatibility.hpp>
+            <rosinterface_handler/logger.hpp>
+            <rosinterface_handler/utilities.hpp>
+            )
+    if(message_filters_FOUND_CATKIN_PROJECT)
+        list(APPEND ${PROJECT_NAME}_interface_pch_headers <message_filters/subscriber.h>)
+    endif()
+    if(diagnostic_updater_FOUND_CATKIN_PROJECT)
+        list(APPEND ${PROJECT_NAME}_interface_pch_headers <diagnostic_updater/diagnostic_updater.h>)
+    endif()
+
     # geninterface target for hard dependency on generate_interface generation
     add_custom_target(${PROJECT_NAME}_geninterface ALL DEPENDS ${${PROJECT_NAME}_interfaces_generated})
 
@@ -117,6 +209,10 @@ macro(generate_ros_interface_files)
     if(dynamic_reconfigure_FOUND_CATKIN_PROJECT)
         if(${PROJECT_NAME}_LOCAL_CFG_FILES)
             generate_dynamic_reconfigure_options(${${PROJECT_NAME}_LOCAL_CFG_FILES})
+            # the .cfg files are byproducts of the geninterface target
+            if(TARGET ${PROJECT_NAME}_gencfg)
+                add_dependencies(${PROJECT_NAME}_gencfg ${PROJECT_NAME}_geninterface)
+            endif()
         endif()
     else()
         message(WARNING "Dependency to dynamic_reconfigure is missing, or find_package(dynamic_reconfigure) was not called yet. Not building dynamic config files")
@@ -158,3 +254,31 @@ macro(install_ros_python_interface_files)
             )
     endif()
 endmacro()
+
+# Precompiles the headers that all generated interfaces include for the given targets, if rosinterface_handler is
+# configured with ROSINTERFACE_HANDLER_PRECOMPILED_HEADERS. Building the pch takes about as long as compiling two files
+# that include an interface, so it is only built once per project: The first target builds it, all other targets
+# reuse it (REUSE_FROM). Reusing requires the same compiler flags, so only pass targets without own compile options or
+# definitions. Otherwise GCC ignores the pch and Clang fails.
+function(rosinterface_handler_precompile_headers)
+    if(NOT ROSINTERFACE_HANDLER_PRECOMPILED_HEADERS)
+        return()
+    endif()
+    if(CMAKE_VERSION VERSION_LESS 3.16)
+        message(WARNING "ROSINTERFACE_HANDLER_PRECOMPILED_HEADERS requires CMake 3.16. Not precompiling headers.")
+        return()
+    endif()
+    if(NOT DEFINED ${PROJECT_NAME}_interface_pch_headers)
+        message(FATAL_ERROR "rosinterface_handler_precompile_headers() must be called after generate_ros_interface_files() in project '${PROJECT_NAME}'")
+    endif()
+    get_property(_pch_target GLOBAL PROPERTY ${PROJECT_NAME}_INTERFACE_PCH_TARGET)
+    foreach(_target ${ARGN})
+        if(_pch_target)
+            target_precompile_headers(${_target} REUSE_FROM ${_pch_target})
+        else()
+            target_precompile_headers(${_target} PRIVATE ${${PROJECT_NAME}_interface_pch_headers})
+            set(_pch_target ${_target})
+            set_property(GLOBAL PROPERTY ${PROJECT_NAME}_INTERFACE_PCH_TARGET ${_target})
+        endif()
+    endforeach()
+endfunction()
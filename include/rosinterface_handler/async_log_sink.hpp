@@ -0,0 +1,164 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <ros/console.h>
+
+namespace rosinterface_handler {
+
+//! Bounded lock free queue for many producers and a single consumer (after D. Vyukov's bounded MPMC queue).
+//! push() never blocks and fails if the queue is full.
+template <typename T, std::size_t Capacity>
+class MpscRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscRingBuffer() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpscRingBuffer(MpscRingBuffer&& rhs) noexcept = delete;
+    MpscRingBuffer& operator=(MpscRingBuffer&& rhs) noexcept = delete;
+    MpscRingBuffer(const MpscRingBuffer& rhs) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer& rhs) = delete;
+    ~MpscRingBuffer() = default;
+
+    //! Adds an element. Can be called from any thread. Returns false if the queue is full.
+    bool push(T&& value) {
+        Cell* cell;
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & (Capacity - 1)];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Removes the oldest element. Must only be called from one thread at a time. Returns false if empty.
+    bool pop(T& value) {
+        Cell& cell = cells_[dequeuePos_ & (Capacity - 1)];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(dequeuePos_ + 1) < 0) {
+            return false;
+        }
+        value = std::move(cell.data);
+        cell.sequence.store(dequeuePos_ + Capacity, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+    std::array<Cell, Capacity> cells_;
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::size_t dequeuePos_{0};
+};
+
+//! A formatted message waiting to be printed by the AsyncLogSink
+struct LogRecord {
+    void* logger{nullptr};
+    ros::console::Level level{ros::console::levels::Info};
+    std::string message;
+    const char* file{nullptr};
+    int line{0};
+    const char* function{nullptr};
+};
+
+//! Prints log messages on a background thread, so that logging never blocks the caller on stdout or rosout.
+//! Messages are dropped if they are logged faster than they can be printed.
+class AsyncLogSink {
+public:
+    static constexpr std::size_t Capacity = 1024;
+
+    AsyncLogSink(AsyncLogSink&& rhs) noexcept = delete;
+    AsyncLogSink& operator=(AsyncLogSink&& rhs) noexcept = delete;
+    AsyncLogSink(const AsyncLogSink& rhs) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink& rhs) = delete;
+    ~AsyncLogSink() {
+        {
+            std::lock_guard<std::mutex> g{mutex_};
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    //! Returns the sink of this process. The printing thread is started on first use.
+    static AsyncLogSink& instance() {
+        static AsyncLogSink sink;
+        return sink;
+    }
+
+    //! Queues a message for printing. Never blocks. Returns false if the message was dropped.
+    bool push(LogRecord&& record) {
+        if (!queue_.push(std::move(record))) {
+            return false;
+        }
+        if (waiting_.load(std::memory_order_relaxed)) {
+            wakeUp_.notify_one();
+        }
+        return true;
+    }
+
+private:
+    AsyncLogSink() : worker_{[this]() { this->run(); }} {
+    }
+
+    void run() {
+        LogRecord record;
+        while (true) {
+            while (queue_.pop(record)) {
+                print(record);
+            }
+            std::unique_lock<std::mutex> lock{mutex_};
+            if (stop_) {
+                break;
+            }
+            waiting_.store(true, std::memory_order_relaxed);
+            // push() does not lock, so a notification can get lost. The timeout bounds the delay in that case.
+            wakeUp_.wait_for(lock, std::chrono::milliseconds(10));
+            waiting_.store(false, std::memory_order_relaxed);
+        }
+        while (queue_.pop(record)) {
+            print(record);
+        }
+    }
+
+    static void print(const LogRecord& record) {
+        std::stringstream ss;
+        ss << record.message;
+        ros::console::print(nullptr, record.logger, record.level, ss, record.file, record.line, record.function);
+    }
+
+    MpscRingBuffer<LogRecord, Capacity> queue_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::atomic<bool> waiting_{false};
+    bool stop_{false};
+    std::thread worker_;
+};
+} // namespace rosinterface_handler
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <ros/node_handle.h>
+#include <ros/publisher.h>
+#include <std_msgs/UInt8MultiArray.h>
+
+#include "serialization.hpp"
+
+namespace rosinterface_handler {
+//! Publishes the parameter values of an interface on a latched std_msgs/UInt8MultiArray topic, so that the
+//! configuration of a node can be recorded in a rosbag at almost no cost.
+//! Every message is a full snapshot in the format of the generated serialize() (layout label "snapshot"), so that the
+//! latched message is enough to know the configuration, no matter when a subscriber (e.g. rosbag record) connects.
+//! Nothing is published if no parameter changed since the last message, so a bag only contains one message per
+//! change of the configuration. The generated applyConfigSnapshot() reads the messages.
+class ConfigSnapshot {
+public:
+    static constexpr const char* Label = "snapshot";
+
+    ConfigSnapshot(ros::NodeHandle nodeHandle, const std::string& topic)
+            : publisher_{nodeHandle.advertise<std_msgs::UInt8MultiArray>(topic, 1, true)} {
+    }
+
+    //! Publishes the serialized values, if they differ from the last published values
+    void publish(SerializationBuffer values) {
+        if (values == last_) {
+            return;
+        }
+        std_msgs::UInt8MultiArray msg;
+        msg.layout.dim.resize(1);
+        msg.layout.dim[0].label = Label;
+        msg.layout.dim[0].size = static_cast<std::uint32_t>(values.size());
+        msg.layout.dim[0].stride = static_cast<std::uint32_t>(values.size());
+        msg.data = values;
+        publisher_.publish(msg);
+        last_ = std::move(values);
+    }
+
+    static bool isSnapshot(const std_msgs::UInt8MultiArray& msg) {
+        return msg.layout.dim.size() == 1 && msg.layout.dim[0].label == Label;
+    }
+
+private:
+    ros::Publisher publisher_;
+    SerializationBuffer last_; //!< empty until the first message, serialized values start with the layout
+};
+} // namespace rosinterface_handler
@@ -1,19 +1,26 @@
 #pragma once
 #define IF_HANDLER_DIAGNOSTICS_INCLUDED
+#include <atomic>
 #include <memory>
-#include <diagnostic_updater/publisher.h>
+#include <mutex>
+#include <diagnostic_updater/diagnostic_updater.h>
+#include <diagnostic_updater/update_functions.h>
 #include <message_filters/subscriber.h>
 #include <ros/forwards.h>
 #include <ros/node_handle.h>
 
 namespace rosinterface_handler {
-//! TopicDiagnostic does not clean up after itself. This wrapper does just that.
+//! Does the same as diagnostic_updater::TopicDiagnostic, but cleans up after itself and works with any task vector
+//! (a diagnostic_updater::Updater or a HubUpdater).
 class TopicDiagnosticWrapper {
 public:
-    TopicDiagnosticWrapper(std::string name, diagnostic_updater::Updater& diag,
+    TopicDiagnosticWrapper(const std::string& name, diagnostic_updater::DiagnosticTaskVector& diag,
                            const diagnostic_updater::FrequencyStatusParam& freq,
                            const diagnostic_updater::TimeStampStatusParam& stamp)
-            : updater_{diag}, diag_(std::move(name), diag, freq, stamp) {
+            : updater_{diag}, diag_{name + " topic status"}, frequency_{freq}, stamp_{stamp} {
+        diag_.addTask(&frequency_);
+        diag_.addTask(&stamp_);
+        updater_.add(diag_);
     }
     TopicDiagnosticWrapper(TopicDiagnosticWrapper&& rhs) noexcept = delete;
     TopicDiagnosticWrapper& operator=(TopicDiagnosticWrapper&& rhs) noexcept = delete;
@@ -25,11 +32,12 @@ public:
     }
 
     void tick() {
-        diag_.tick();
+        frequency_.tick();
     }
 
     void tick(const ros::Time& stamp) {
-        diag_.tick(stamp);
+        stamp_.tick(stamp);
+        frequency_.tick();
     }
 
     const std::string& name() {
@@ -37,8 +45,10 @@ public:
     }
 
 private:
-    diagnostic_updater::Updater& updater_;
-    diagnostic_updater::TopicDiagnostic diag_;
+    diagnostic_updater::DiagnosticTaskVector& updater_;
+    diagnostic_updater::CompositeDiagnosticTask diag_;
+    diagnostic_updater::FrequencyStatus frequency_;
+    diagnostic_updater::TimeStampStatus stamp_;
 };
 
 //! Like a message_filters::Subscriber, but also manages diagnostics.
@@ -52,7 +62,7 @@ class DiagnosedSubscriber : public SubscriberBase {
 public:
     template <typename... Args>
     // NOLINTNEXTLINE(readability-identifier-naming)
-    explicit DiagnosedSubscriber(diagnostic_updater::Updater& updater, Args&&... args)
+    explicit DiagnosedSubscriber(diagnostic_updater::DiagnosticTaskVector& updater, Args&&... args)
             : SubscriberBase(std::forward<Args>(args)...), updater_{updater} {
         SubscriberT::registerCallback([this](const MsgPtrT& msg) { this->onMessage(msg); });
     }
@@ -104,38 +114,35 @@ private:
     double minFreq_{0.};
     double maxFreq_{std::numeric_limits<double>::infinity()};
     double maxTimeDelay_{0.};
-    diagnostic_updater::Updater& updater_;
+    diagnostic_updater::DiagnosticTaskVector& updater_;
     std::unique_ptr<TopicDiagnosticWrapper> diagnostic_;
 };
 
 //! Similar to diagnostic_updater::DiagnosedPublisher, but with less segfaults and a simpler interface. Low frequency
 //! and delay are only treated as warnings/errors if there are actually subscribers on the advertised topic.
+//! The thresholds can be changed at any time without re-registering the publisher at the updater. Copies share the
+//! thresholds and the advertised publisher, changing the thresholds of one copy changes them for all copies.
 template <typename MsgT>
 class DiagnosedPublisher {
     static_assert(ros::message_traits::HasHeader<MsgT>::value,
                   "DiagnosedPublisher can only be used on messages with a header!");
-    using Publisher = diagnostic_updater::DiagnosedPublisher<const MsgT>;
+    //! The only place where the thresholds are stored. Read by the updater callback when it runs.
+    struct Thresholds {
+        std::atomic<double> minFreq{0.};
+        std::atomic<double> maxTimeDelay{0.};
+    };
+
     class PublisherData {
     public:
-        PublisherData(diagnostic_updater::Updater& updater, const ros::Publisher& publisher, double minFreq,
-                      double maxTimeDelay)
-                : minFreq_{minFreq}, updater_{&updater},
-                  publisher_{publisher, updater, diagnostic_updater::FrequencyStatusParam(&minFreq_, &maxFreq_, 0.),
-                             diagnostic_updater::TimeStampStatusParam(0., maxTimeDelay)} {
-            // We want to control the result of the updater ourselves. Therefore we remove the callback registered by
-            // the Publisher and replace it with our own callback.
-            auto name = publisher_.getName();
-            updater.removeByName(name);
-            updater.add(name, [&](diagnostic_updater::DiagnosticStatusWrapper& msg) {
-                publisher_.run(msg);
-                if (getNumSubscribers() == 0) {
-                    msg.level = diagnostic_msgs::DiagnosticStatus::OK;
-                    msg.message = "No subscribers; " + msg.message;
-                }
-            });
+        PublisherData(diagnostic_updater::DiagnosticTaskVector& updater, const ros::Publisher& publisher,
+                      std::shared_ptr<const Thresholds> thresholds)
+                : thresholds_{std::move(thresholds)}, updater_{&updater}, publisher_{publisher},
+                  name_{publisher.getTopic() + " topic status"},
+                  frequency_{diagnostic_updater::FrequencyStatusParam(&minFreqSnapshot_, &maxFreq_, 0.)} {
+            updater.add(name_, [this](diagnostic_updater::DiagnosticStatusWrapper& msg) { this->run(msg); });
         }
         ~PublisherData() {
-            updater_->removeByName(publisher_.getName());
+            updater_->removeByName(name_);
         }
         PublisherData() noexcept = delete;
         PublisherData(PublisherData&& rhs) noexcept = delete;
@@ -143,27 +150,95 @@ class DiagnosedPublisher {
         PublisherData(const PublisherData& rhs) = delete;
         PublisherData& operator=(const PublisherData& rhs) = delete;
 
-        template <typename T>
-        void publish(const T& msg) {
+        void publish(const boost::shared_ptr<const MsgT>& msg) {
+            publisher_.publish(msg);
+            tick(msg->header.stamp);
+        }
+
+        void publish(const MsgT& msg) {
             publisher_.publish(msg);
+            tick(msg.header.stamp);
         }
 
         uint32_t getNumSubscribers() const {
-            return publisher_.getPublisher().getNumSubscribers();
+            return publisher_.getNumSubscribers();
         }
         ros::Publisher publisher() const {
-            return publisher_.getPublisher();
+            return publisher_;
         }
 
     private:
-        double minFreq_{0.};
+        void tick(const ros::Time& stamp) {
+            frequency_.tick();
+            std::lock_guard<std::mutex> g{stampMutex_};
+            if (stamp.isZero()) {
+                zeroSeen_ = true;
+                return;
+            }
+            const double delay = (ros::Time::now() - stamp).toSec();
+            if (!delaysValid_ || delay > maxDelay_) {
+                maxDelay_ = delay;
+            }
+            if (!delaysValid_ || delay < minDelay_) {
+                minDelay_ = delay;
+            }
+            delaysValid_ = true;
+        }
+
+        // Called by the updater. Does the same as diagnostic_updater::TimeStampStatus, but reads the thresholds live.
+        // NOLINTNEXTLINE(readability-function-size)
+        void run(diagnostic_updater::DiagnosticStatusWrapper& msg) {
+            minFreqSnapshot_ = thresholds_->minFreq.load(std::memory_order_relaxed);
+            const double maxTimeDelay = thresholds_->maxTimeDelay.load(std::memory_order_relaxed);
+            frequency_.run(msg);
+            {
+                std::lock_guard<std::mutex> g{stampMutex_};
+                if (!delaysValid_) {
+                    msg.mergeSummary(diagnostic_msgs::DiagnosticStatus::WARN, "No data since last update.");
+                } else {
+                    if (minDelay_ < MinTimeDelay) {
+                        msg.mergeSummary(diagnostic_msgs::DiagnosticStatus::ERROR,
+                                         "Timestamps too far in future seen.");
+                    }
+                    if (maxDelay_ > maxTimeDelay) {
+                        msg.mergeSummary(diagnostic_msgs::DiagnosticStatus::ERROR, "Timestamps too far in past seen.");
+                    }
+                }
+                if (zeroSeen_) {
+                    msg.mergeSummary(diagnostic_msgs::DiagnosticStatus::ERROR, "Zero timestamp seen.");
+                }
+                msg.addf("Earliest timestamp delay:", "%f", minDelay_);
+                msg.addf("Latest timestamp delay:", "%f", maxDelay_);
+                msg.addf("Earliest acceptable timestamp delay:", "%f", MinTimeDelay);
+                msg.addf("Latest acceptable timestamp delay:", "%f", maxTimeDelay);
+                delaysValid_ = false;
+                zeroSeen_ = false;
+                minDelay_ = 0.;
+                maxDelay_ = 0.;
+            }
+            if (getNumSubscribers() == 0) {
+                msg.level = diagnostic_msgs::DiagnosticStatus::OK;
+                msg.message = "No subscribers; " + msg.message;
+            }
+        }
+
+        static constexpr double MinTimeDelay = 0.;
+        std::shared_ptr<const Thresholds> thresholds_;
+        double minFreqSnapshot_{0.}; //!< only accessed by the updater, FrequencyStatus points to it
         double maxFreq_{1.e8};
-        diagnostic_updater::Updater* updater_{nullptr};
-        Publisher publisher_;
+        diagnostic_updater::DiagnosticTaskVector* updater_{nullptr};
+        ros::Publisher publisher_;
+        std::string name_;
+        diagnostic_updater::FrequencyStatus frequency_;
+        std::mutex stampMutex_;
+        bool delaysValid_{false};
+        bool zeroSeen_{false};
+        double minDelay_{0.};
+        double maxDelay_{0.};
     };
 
 public:
-    explicit DiagnosedPublisher(diagnostic_updater::Updater& updater) : updater_{&updater} {
+    explicit DiagnosedPublisher(diagnostic_updater::DiagnosticTaskVector& updater) : updater_{&updater} {
     }
     DiagnosedPublisher() noexcept = default;
     DiagnosedPublisher(DiagnosedPublisher&& rhs) noexcept = default;
@@ -190,18 +265,12 @@ public:
     }
 
     DiagnosedPublisher& minFrequency(double minFrequency) {
-        minFreq_ = minFrequency;
-        if (!!publisherData_) {
-            reset(publisherData_->publisher());
-        }
+        thresholds().minFreq.store(minFrequency, std::memory_order_relaxed);
         return *this;
     }
 
     DiagnosedPublisher& maxTimeDelay(double maxTimeDelay) {
-        maxTimeDelay_ = maxTimeDelay;
-        if (!!publisherData_) {
-            reset(publisherData_->publisher());
-        }
+        thresholds().maxTimeDelay.store(maxTimeDelay, std::memory_order_relaxed);
         return *this;
     }
 
@@ -222,11 +291,19 @@ public:
 
 private:
     void reset(const ros::Publisher& publisher) {
-        publisherData_ = std::make_shared<PublisherData>(*updater_, publisher, minFreq_, maxTimeDelay_);
+        thresholds();
+        publisherData_ = std::make_shared<PublisherData>(*updater_, publisher, thresholds_);
     }
-    double minFreq_{0.};
-    double maxTimeDelay_{0.};
-    diagnostic_updater::Updater* updater_{nullptr};
+
+    Thresholds& thresholds() {
+        if (!thresholds_) {
+            thresholds_ = std::make_shared<Thresholds>();
+        }
+        return *thresholds_;
+    }
+
+    std::shared_ptr<Thresholds> thresholds_;
+    diagnostic_updater::DiagnosticTaskVector* updater_{nullptr};
     std::shared_ptr<PublisherData> publisherData_;
 };
 } // namespace rosinterface_handler
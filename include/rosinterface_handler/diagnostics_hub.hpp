@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <diagnostic_updater/diagnostic_updater.h>
+#include <ros/init.h>
+#include <ros/node_handle.h>
+
+namespace rosinterface_handler {
+class HubUpdater;
+
+//! Collects the diagnostics of all HubUpdaters in this process (e.g. all nodelets in a nodelet manager) and publishes
+//! them as a single DiagnosticArray per period. All updaters share one timer thread instead of one timer each.
+class DiagnosticsHub {
+public:
+    DiagnosticsHub(DiagnosticsHub&& rhs) noexcept = delete;
+    DiagnosticsHub& operator=(DiagnosticsHub&& rhs) noexcept = delete;
+    DiagnosticsHub(const DiagnosticsHub& rhs) = delete;
+    DiagnosticsHub& operator=(const DiagnosticsHub& rhs) = delete;
+    ~DiagnosticsHub() {
+        {
+            std::lock_guard<std::mutex> g{mutex_};
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    //! Returns the hub of this process
+    static DiagnosticsHub& instance() {
+        static DiagnosticsHub hub;
+        return hub;
+    }
+
+    //! Registers an updater. The first registration starts the publishing thread.
+    void add(HubUpdater& updater) {
+        std::lock_guard<std::mutex> g{mutex_};
+        updaters_.push_back(&updater);
+        if (!worker_.joinable()) {
+            publisher_ = ros::NodeHandle().advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 1);
+            worker_ = std::thread([this]() { this->run(); });
+        }
+    }
+
+    //! Unregisters an updater. Blocks while the hub is collecting its status.
+    void remove(HubUpdater& updater) {
+        std::lock_guard<std::mutex> g{mutex_};
+        updaters_.erase(std::remove(updaters_.begin(), updaters_.end(), &updater), updaters_.end());
+    }
+
+    //! Publishes the diagnostics of all updaters as soon as possible (instead of waiting for the next period)
+    void requestUpdate() {
+        {
+            std::lock_guard<std::mutex> g{mutex_};
+            updateRequested_ = true;
+        }
+        wakeUp_.notify_all();
+    }
+
+    //! Sets the publishing period in seconds (default: 1s)
+    void setPeriod(double period) {
+        std::lock_guard<std::mutex> g{mutex_};
+        period_ = std::chrono::duration<double>(period);
+    }
+
+private:
+    DiagnosticsHub() = default;
+
+    // NOLINTNEXTLINE(readability-function-size)
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::vector<HubUpdater*> updaters_;
+    ros::Publisher publisher_;
+    std::thread worker_;
+    std::chrono::duration<double> period_{1.};
+    bool stop_{false};
+    bool updateRequested_{false};
+};
+
+//! Holds diagnostic tasks like a diagnostic_updater::Updater, but does not publish by itself. The DiagnosticsHub
+//! collects the tasks of all HubUpdaters instead. Everything that takes a diagnostic_updater::DiagnosticTaskVector
+//! (e.g. DiagnosedSubscriber, DiagnosedPublisher) can register its tasks here.
+//! update() is a no-op and force_update() asks the hub to publish as soon as possible.
+class HubUpdater : public diagnostic_updater::DiagnosticTaskVector {
+public:
+    explicit HubUpdater(std::string nodeName = ros::this_node::getName()) : nodeName_{std::move(nodeName)} {
+        DiagnosticsHub::instance().add(*this);
+    }
+    HubUpdater(HubUpdater&& rhs) noexcept = delete;
+    HubUpdater& operator=(HubUpdater&& rhs) noexcept = delete;
+    HubUpdater(const HubUpdater& rhs) = delete;
+    HubUpdater& operator=(const HubUpdater& rhs) = delete;
+    ~HubUpdater() override {
+        DiagnosticsHub::instance().remove(*this);
+    }
+
+    //! The hub publishes periodically, nothing to do here
+    void update() {
+    }
+
+    //! Publishes the diagnostics of all updaters in this process as soon as possible
+    void force_update() { // NOLINT(readability-identifier-naming)
+        DiagnosticsHub::instance().requestUpdate();
+    }
+
+    void setHardwareID(const std::string& hardwareId) { // NOLINT(readability-identifier-naming)
+        boost::mutex::scoped_lock lock(lock_);
+        hardwareId_ = hardwareId;
+    }
+
+    //! Runs all tasks and appends their status to statusVec. Called by the hub.
+    void collect(std::vector<diagnostic_msgs::DiagnosticStatus>& statusVec) {
+        boost::mutex::scoped_lock lock(lock_);
+        const std::string prefix = (nodeName_.empty() || nodeName_[0] != '/' ? nodeName_ : nodeName_.substr(1)) + ": ";
+        for (const auto& task : getTasks()) {
+            diagnostic_updater::DiagnosticStatusWrapper status;
+            status.name = task.getName();
+            status.level = diagnostic_msgs::DiagnosticStatus::ERROR;
+            status.message = "No message was set";
+            status.hardware_id = hardwareId_;
+            task.run(status);
+            status.name = prefix + status.name;
+            statusVec.push_back(status);
+        }
+    }
+
+private:
+    std::string nodeName_;
+    std::string hardwareId_;
+};
+
+inline void DiagnosticsHub::run() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (!stop_) {
+        wakeUp_.wait_for(lock, period_, [this]() { return stop_ || updateRequested_; });
+        if (stop_) {
+            break;
+        }
+        updateRequested_ = false;
+        if (updaters_.empty() || !ros::ok()) {
+            continue;
+        }
+        diagnostic_msgs::DiagnosticArray msg;
+        for (auto* updater : updaters_) {
+            updater->collect(msg.status);
+        }
+        msg.header.stamp = ros::Time::now();
+        publisher_.publish(msg);
+    }
+}
+} // namespace rosinterface_handler
@@ -0,0 +1,24 @@
+#pragma once
+#include <Eigen/Core>
+
+#include "utilities.hpp"
+
+namespace rosinterface_handler {
+namespace detail {
+/// \brief Fixed size Eigen matrices and vectors are parameters with a fixed size. The elements are listed in row major
+/// order on the parameter server, no matter how the matrix is stored.
+template <typename S, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct FixedSizeParam<Eigen::Matrix<S, Rows, Cols, Options, MaxRows, MaxCols>, std::enable_if_t<(Rows > 0 && Cols > 0)>>
+        : std::true_type {
+    using Type = Eigen::Matrix<S, Rows, Cols, Options, MaxRows, MaxCols>;
+    using Scalar = S;
+    static constexpr std::size_t Size = static_cast<std::size_t>(Rows) * static_cast<std::size_t>(Cols);
+    static S& at(Type& val, std::size_t i) {
+        return val(static_cast<Eigen::Index>(i / Cols), static_cast<Eigen::Index>(i % Cols));
+    }
+    static const S& at(const Type& val, std::size_t i) {
+        return val(static_cast<Eigen::Index>(i / Cols), static_cast<Eigen::Index>(i % Cols));
+    }
+};
+} // namespace detail
+} // namespace rosinterface_handler
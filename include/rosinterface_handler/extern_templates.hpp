@@ -0,0 +1,36 @@
+#pragma once
+// The subscriber and publisher templates for the most common message types are compiled once into the
+// rosinterface_handler_templates library (see src/extern_templates.cpp). If it is used (i.e.
+// ROSINTERFACE_HANDLER_EXTERN_TEMPLATES is defined), they are declared extern here, so that they are not instantiated
+// again in every file that includes a generated interface.
+#ifdef ROSINTERFACE_HANDLER_EXTERN_TEMPLATES
+#include <sensor_msgs/CameraInfo.h>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/Imu.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <std_msgs/Header.h>
+
+#include "diagnostic_subscriber.hpp"
+#include "smart_subscriber.hpp"
+
+/// \brief Calls Instantiate(Prefix, Msg) for every message type in the library. Diagnosed subscribers and publishers
+/// need a message with a header, so std_msgs::Header is only instantiated as (smart) subscriber.
+#define ROSINTERFACE_HANDLER_FOR_COMMON_MESSAGES(Instantiate, Prefix) \
+    Instantiate(Prefix, sensor_msgs::CameraInfo)                      \
+    Instantiate(Prefix, sensor_msgs::Image)                           \
+    Instantiate(Prefix, sensor_msgs::Imu)                             \
+    Instantiate(Prefix, sensor_msgs::PointCloud2)
+
+#define ROSINTERFACE_HANDLER_INSTANTIATE_SUBSCRIBER(Prefix, Msg) \
+    Prefix template class message_filters::Subscriber<Msg>;      \
+    Prefix template class rosinterface_handler::SmartSubscriber<Msg>;
+
+#define ROSINTERFACE_HANDLER_INSTANTIATE_DIAGNOSED(Prefix, Msg)                                                       \
+    ROSINTERFACE_HANDLER_INSTANTIATE_SUBSCRIBER(Prefix, Msg)                                                          \
+    Prefix template class rosinterface_handler::DiagnosedSubscriber<Msg>;                                             \
+    Prefix template class rosinterface_handler::DiagnosedSubscriber<Msg, rosinterface_handler::SmartSubscriber<Msg>>; \
+    Prefix template class rosinterface_handler::DiagnosedPublisher<Msg>;
+
+ROSINTERFACE_HANDLER_INSTANTIATE_SUBSCRIBER(extern, std_msgs::Header)
+ROSINTERFACE_HANDLER_FOR_COMMON_MESSAGES(ROSINTERFACE_HANDLER_INSTANTIATE_DIAGNOSED, extern)
+#endif
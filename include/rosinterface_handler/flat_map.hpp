@@ -0,0 +1,301 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rosinterface_handler {
+
+//! Map that stores its entries sorted by key in one contiguous vector. It has the lookup interface of std::map, but
+//! a lookup is a binary search over contiguous memory and never allocates. Keys can also be looked up by any type that
+//! is comparable to Key (e.g. a std::string_view or a string literal for std::string keys).
+//! Inserting and erasing is linear, so it is meant for maps that are built once (e.g. parameters) and read often.
+//! Like with std::map, the keys can not be changed through an iterator: Dereferencing one returns a
+//! std::pair<const Key&, T&> (or std::pair<const Key&, const T&>), which refers to the stored entry.
+template <typename Key, typename T, typename Compare = std::less<>>
+class FlatMap {
+    using storage_type = std::pair<Key, T>;
+
+    //! Random access iterator over the stored entries that only gives const access to the keys
+    template <bool Const>
+    class Iterator {
+        using Base = std::conditional_t<Const, typename std::vector<storage_type>::const_iterator,
+                                        typename std::vector<storage_type>::iterator>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, std::conditional_t<Const, const T&, T&>>;
+        //! Holds the reference, so that it->second works
+        struct pointer {
+            reference ref;
+            const reference* operator->() const noexcept {
+                return &ref;
+            }
+        };
+
+        Iterator() = default;
+        explicit Iterator(Base it) : it_{it} {
+        }
+        //! iterator converts to const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& it) : it_{it.base()} { // NOLINT(google-explicit-constructor)
+        }
+
+        Base base() const noexcept {
+            return it_;
+        }
+        reference operator*() const noexcept {
+            return {it_->first, it_->second};
+        }
+        pointer operator->() const noexcept {
+            return pointer{**this};
+        }
+        reference operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        Iterator& operator++() noexcept {
+            ++it_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            return Iterator(it_++);
+        }
+        Iterator& operator--() noexcept {
+            --it_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            return Iterator(it_--);
+        }
+        Iterator& operator+=(difference_type n) noexcept {
+            it_ += n;
+            return *this;
+        }
+        Iterator& operator-=(difference_type n) noexcept {
+            it_ -= n;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        friend Iterator operator+(difference_type n, Iterator it) noexcept {
+            return it += n;
+        }
+        friend Iterator operator-(Iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ - rhs.it_;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ == rhs.it_;
+        }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ != rhs.it_;
+        }
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ < rhs.it_;
+        }
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ > rhs.it_;
+        }
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ <= rhs.it_;
+        }
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.it_ >= rhs.it_;
+        }
+
+    private:
+        Base it_{};
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using key_compare = Compare;
+    using container_type = std::vector<storage_type>;
+    using size_type = typename container_type::size_type;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatMap() = default;
+    FlatMap(std::initializer_list<value_type> init) : FlatMap(container_type(init.begin(), init.end())) {
+    }
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last) : FlatMap(container_type(first, last)) {
+    }
+    //! Takes any values. If a key exists more than once, the first value is kept (as std::map would do).
+    explicit FlatMap(container_type values) : values_{std::move(values)} {
+        std::stable_sort(values_.begin(), values_.end(), [this](const storage_type& lhs, const storage_type& rhs) {
+            return compare_(lhs.first, rhs.first);
+        });
+        auto last =
+            std::unique(values_.begin(), values_.end(), [this](const storage_type& lhs, const storage_type& rhs) {
+                return !compare_(lhs.first, rhs.first) && !compare_(rhs.first, lhs.first);
+            });
+        values_.erase(last, values_.end());
+    }
+
+    template <typename K>
+    iterator find(const K& key) {
+        const auto& k = lookupKey(key);
+        auto it = lowerBound(k);
+        return iterator(it != values_.end() && !compare_(k, it->first) ? it : values_.end());
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const {
+        const auto& k = lookupKey(key);
+        auto it = lowerBound(k);
+        return const_iterator(it != values_.end() && !compare_(k, it->first) ? it : values_.end());
+    }
+
+    template <typename K>
+    size_type count(const K& key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    template <typename K>
+    T& at(const K& key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return it->second;
+    }
+
+    template <typename K>
+    const T& at(const K& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return it->second;
+    }
+
+    //! Returns the value of key. Inserts a default constructed value if key does not exist.
+    T& operator[](const Key& key) {
+        auto it = lowerBound(key);
+        if (it == values_.end() || compare_(key, it->first)) {
+            it = values_.emplace(it, key, T{});
+        }
+        return it->second;
+    }
+
+    //! Inserts value if its key does not exist yet
+    std::pair<iterator, bool> insert(const value_type& value) {
+        auto it = lowerBound(value.first);
+        if (it != values_.end() && !compare_(value.first, it->first)) {
+            return {iterator(it), false};
+        }
+        return {iterator(values_.insert(it, storage_type(value))), true};
+    }
+
+    iterator erase(iterator pos) {
+        return iterator(values_.erase(pos.base()));
+    }
+
+    iterator erase(const_iterator pos) {
+        return iterator(values_.erase(pos.base()));
+    }
+
+    //! Erases the value of key. Iterators are erased by the overloads above, not looked up as key.
+    template <typename K, typename = std::enable_if_t<!std::is_convertible<const K&, const_iterator>::value>>
+    size_type erase(const K& key) {
+        auto it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        values_.erase(it.base());
+        return 1;
+    }
+
+    void clear() noexcept {
+        values_.clear();
+    }
+
+    void reserve(size_type size) {
+        values_.reserve(size);
+    }
+
+    size_type size() const noexcept {
+        return values_.size();
+    }
+
+    bool empty() const noexcept {
+        return values_.empty();
+    }
+
+    iterator begin() noexcept {
+        return iterator(values_.begin());
+    }
+    iterator end() noexcept {
+        return iterator(values_.end());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(values_.begin());
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(values_.end());
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(values_.cbegin());
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(values_.cend());
+    }
+
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) {
+        return lhs.values_ == rhs.values_;
+    }
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    //! String keys are compared as std::string_view, so that string literals are not measured in every comparison
+    template <typename K>
+    static decltype(auto) lookupKey(const K& key) {
+        if constexpr (std::is_same<Key, std::string>::value && std::is_convertible<const K&, std::string_view>::value) {
+            return std::string_view(key);
+        } else {
+            return (key);
+        }
+    }
+
+    template <typename K>
+    typename container_type::iterator lowerBound(const K& key) {
+        return std::lower_bound(values_.begin(), values_.end(), key,
+                                [this](const storage_type& value, const K& k) { return compare_(value.first, k); });
+    }
+
+    template <typename K>
+    typename container_type::const_iterator lowerBound(const K& key) const {
+        return std::lower_bound(values_.begin(), values_.end(), key,
+                                [this](const storage_type& value, const K& k) { return compare_(value.first, k); });
+    }
+
+    container_type values_;
+    Compare compare_;
+};
+
+/// \brief Helper function to test for FlatMap
+template <typename T>
+struct IsFlatMap : std::false_type {};
+
+template <typename Key, typename T, typename Compare>
+struct IsFlatMap<FlatMap<Key, T, Compare>> : std::true_type {};
+} // namespace rosinterface_handler
@@ -0,0 +1,121 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "utilities.hpp"
+
+namespace rosinterface_handler {
+
+/// \brief Appends str as quoted and escaped JSON string
+inline void appendJsonString(StringBuilder& out, std::string_view str) {
+    out.append('"');
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        const auto c = static_cast<unsigned char>(str[i]);
+        if (c != '"' && c != '\\' && c >= 0x20) {
+            continue;
+        }
+        out.append(str.substr(begin, i - begin));
+        begin = i + 1;
+        switch (c) {
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        case '\r':
+            out.append("\\r");
+            break;
+        case '\t':
+            out.append("\\t");
+            break;
+        default:
+            std::array<char, 7> escaped{};
+            std::snprintf(escaped.data(), escaped.size(), "\\u%04x", c); // NOLINT(cppcoreguidelines-pro-type-vararg)
+            out.append(std::string_view(escaped.data(), 6));
+        }
+    }
+    out.append(str.substr(begin));
+    out.append('"');
+}
+
+/// \brief Appends val as JSON value. Numbers are written so that they can be read back exactly, NaN and infinity
+/// (which JSON does not know) as null. Maps are written as object, fixed size types (std::array, Eigen) as array of
+/// their elements in row major order.
+template <typename T>
+inline void appendJson(StringBuilder& out, const T& val) {
+    if constexpr (std::is_same<T, bool>::value) {
+        out.append(val ? std::string_view("true") : std::string_view("false"));
+    } else if constexpr (std::is_integral<T>::value) {
+        // also prints (u)int8_t as number
+        out.append(static_cast<std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>>(val));
+    } else if constexpr (std::is_floating_point<T>::value) {
+        if (!std::isfinite(val)) {
+            out.append("null");
+            return;
+        }
+        std::array<char, 32> chars;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::to_chars(chars.data(), chars.data() + chars.size(), val);
+        out.append(std::string_view(chars.data(), static_cast<std::size_t>(result.ptr - chars.data())));
+#else
+        const auto size = std::snprintf(chars.data(), chars.size(), "%.*g", // NOLINT(cppcoreguidelines-pro-type-vararg)
+                                        std::numeric_limits<T>::max_digits10, static_cast<double>(val));
+        out.append(std::string_view(chars.data(), static_cast<std::size_t>(size)));
+#endif
+    } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+        appendJsonString(out, std::string_view(val));
+    } else if constexpr (std::is_convertible<const T&, const std::string&>::value) {
+        appendJsonString(out, static_cast<const std::string&>(val));
+    } else if constexpr (detail::FixedSizeParam<T>::value) {
+        out.append('[');
+        for (std::size_t i = 0; i < detail::FixedSizeParam<T>::Size; ++i) {
+            if (i > 0) {
+                out.append(',');
+            }
+            appendJson(out, detail::FixedSizeParam<T>::at(val, i));
+        }
+        out.append(']');
+    } else if constexpr (detail::IsMapParam<T>::value) {
+        out.append('{');
+        bool first = true;
+        for (const auto& elem : val) {
+            if (!first) {
+                out.append(',');
+            }
+            first = false;
+            if constexpr (std::is_convertible<const typename T::key_type&, std::string_view>::value) {
+                appendJsonString(out, std::string_view(elem.first));
+            } else {
+                appendJsonString(out, asString(elem.first));
+            }
+            out.append(':');
+            appendJson(out, elem.second);
+        }
+        out.append('}');
+    } else {
+        static_assert(detail::IsListParam<T>::value, "Type can not be written as JSON");
+        out.append('[');
+        bool first = true;
+        for (const auto& elem : val) {
+            if (!first) {
+                out.append(',');
+            }
+            first = false;
+            appendJson<typename T::value_type>(out, elem);
+        }
+        out.append(']');
+    }
+}
+} // namespace rosinterface_handler
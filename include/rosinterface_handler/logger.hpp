@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <ros/console.h>
+#include <ros/time.h>
+
+#include "async_log_sink.hpp"
+#include "utilities.hpp"
+
+/// \brief Logs to a rosinterface_handler::Logger if the level is enabled. Arguments are only formatted if enabled.
+#define ROSINTERFACE_LOG(logger, level, ...)                                  \
+    do {                                                                      \
+        if ((logger).isEnabled(level)) {                                      \
+            (logger).print(level, __FILE__, __LINE__, __func__, __VA_ARGS__); \
+        }                                                                     \
+    } while (false)
+
+/// \brief Logs to a rosinterface_handler::Logger at most once every period seconds. The throttle state is kept per
+/// call site, so a noisy call site does not suppress others.
+#define ROSINTERFACE_LOG_THROTTLE(logger, level, period, ...)                       \
+    do {                                                                            \
+        static ::rosinterface_handler::ThrottleState rosinterfaceThrottleState;     \
+        if ((logger).isEnabled(level) && rosinterfaceThrottleState.check(period)) { \
+            (logger).print(level, __FILE__, __LINE__, __func__, __VA_ARGS__);       \
+        }                                                                           \
+    } while (false)
+
+#define ROSINTERFACE_DEBUG(logger, ...) ROSINTERFACE_LOG(logger, ::ros::console::levels::Debug, __VA_ARGS__)
+#define ROSINTERFACE_INFO(logger, ...) ROSINTERFACE_LOG(logger, ::ros::console::levels::Info, __VA_ARGS__)
+#define ROSINTERFACE_WARN(logger, ...) ROSINTERFACE_LOG(logger, ::ros::console::levels::Warn, __VA_ARGS__)
+#define ROSINTERFACE_ERROR(logger, ...) ROSINTERFACE_LOG(logger, ::ros::console::levels::Error, __VA_ARGS__)
+#define ROSINTERFACE_INFO_THROTTLE(logger, period, ...) \
+    ROSINTERFACE_LOG_THROTTLE(logger, ::ros::console::levels::Info, period, __VA_ARGS__)
+#define ROSINTERFACE_WARN_THROTTLE(logger, period, ...) \
+    ROSINTERFACE_LOG_THROTTLE(logger, ::ros::console::levels::Warn, period, __VA_ARGS__)
+#define ROSINTERFACE_ERROR_THROTTLE(logger, period, ...) \
+    ROSINTERFACE_LOG_THROTTLE(logger, ::ros::console::levels::Error, period, __VA_ARGS__)
+
+namespace rosinterface_handler {
+
+//! Remembers when a throttled message was printed the last time
+class ThrottleState {
+public:
+    //! Returns true if at least period seconds passed since the last time this returned true
+    bool check(double period) {
+        const double now = ros::Time::now().toSec();
+        double lastHit = lastHit_.load(std::memory_order_relaxed);
+        return now >= lastHit + period && lastHit_.compare_exchange_strong(lastHit, now, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> lastHit_{0.};
+};
+
+//! A named rosconsole logger. The log locations for all levels are resolved once on construction, so that logging
+//! does not have to look up the logger by name on every call (as the ROS_*_NAMED macros do).
+//! In async mode, messages are formatted by the caller but printed by the AsyncLogSink.
+class Logger {
+    using Locations = std::array<ros::console::LogLocation, ros::console::levels::Count>;
+    struct Entry {
+        Locations locations;
+        std::atomic<std::uint64_t> dropped{0};
+    };
+
+public:
+    //! Creates a logger with the full rosconsole name (e.g. ROSCONSOLE_NAME_PREFIX + "." + name)
+    explicit Logger(const std::string& name, bool async = false) : entry_{&entryFor(name)}, async_{async} {
+    }
+
+    //! Returns true if messages of this level are printed
+    bool isEnabled(ros::console::Level level) const {
+        return entry_->locations[level].logger_enabled_;
+    }
+
+    //! Formats and prints a message, no matter whether the level is enabled or not
+    template <typename... Args>
+    void print(ros::console::Level level, const char* file, int line, const char* function,
+               const Args&... args) const {
+        const auto& location = entry_->locations[level];
+        if (async_) {
+            LogRecord record{location.logger_, location.level_, asString(args...), file, line, function};
+            if (!AsyncLogSink::instance().push(std::move(record))) {
+                entry_->dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        std::stringstream ss;
+        ss << streamed(args...);
+        ros::console::print(nullptr, location.logger_, location.level_, ss, file, line, function);
+    }
+
+    //! Returns true if messages are printed by the AsyncLogSink
+    bool isAsync() const {
+        return async_;
+    }
+
+    //! Number of messages of this logger that were dropped because the AsyncLogSink was full
+    std::uint64_t droppedMessages() const {
+        return entry_->dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    static Entry& entryFor(const std::string& name) {
+        // rosconsole keeps pointers to all initialized locations and updates them when the levels change. Therefore
+        // they are never freed.
+        static auto* pool = new std::map<std::string, Entry>(); // NOLINT(cppcoreguidelines-owning-memory)
+        static std::mutex poolMutex;
+        std::lock_guard<std::mutex> g{poolMutex};
+        auto it = pool->find(name);
+        if (it != pool->end()) {
+            return it->second;
+        }
+        ROSCONSOLE_AUTOINIT;
+        auto& entry = (*pool)[name];
+        for (int level = 0; level < ros::console::levels::Count; ++level) {
+            auto& location = entry.locations[level];
+            location = ros::console::LogLocation{false, false, ros::console::levels::Count, nullptr};
+            ros::console::initializeLogLocation(&location, name, static_cast<ros::console::Level>(level));
+        }
+        return entry;
+    }
+
+    Entry* entry_;
+    bool async_;
+};
+} // namespace rosinterface_handler
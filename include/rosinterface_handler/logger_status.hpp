@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <diagnostic_updater/diagnostic_updater.h>
+
+#include "logger.hpp"
+#include "utilities.hpp"
+
+namespace rosinterface_handler {
+//! Reports log messages of an asynchronous Logger that were dropped because the AsyncLogSink overflowed.
+//! The status is WARN if messages were dropped since the last report.
+class LoggerStatus {
+public:
+    LoggerStatus(const std::string& statusDescription, const Logger& logger,
+                 diagnostic_updater::DiagnosticTaskVector& updater)
+            : logger_{&logger}, updater_{&updater}, name_{statusDescription} {
+        updater_->add(name_, [this](diagnostic_updater::DiagnosticStatusWrapper& w) { this->getStatus(w); });
+    }
+    LoggerStatus(LoggerStatus&& rhs) noexcept = delete;
+    LoggerStatus& operator=(LoggerStatus&& rhs) noexcept = delete;
+    LoggerStatus(const LoggerStatus& rhs) = delete;
+    LoggerStatus& operator=(const LoggerStatus& rhs) = delete;
+    ~LoggerStatus() {
+        updater_->removeByName(name_);
+    }
+
+private:
+    void getStatus(diagnostic_updater::DiagnosticStatusWrapper& w) {
+        const auto dropped = logger_->droppedMessages();
+        if (dropped > lastDropped_) {
+            w.summary(diagnostic_msgs::DiagnosticStatus::WARN,
+                      asString(dropped - lastDropped_, " log messages dropped, logging is too fast"));
+        } else {
+            w.summary(diagnostic_msgs::DiagnosticStatus::OK, "OK");
+        }
+        w.add("Dropped messages", dropped);
+        lastDropped_ = dropped;
+    }
+
+    const Logger* logger_;
+    diagnostic_updater::DiagnosticTaskVector* updater_;
+    std::string name_;
+    std::uint64_t lastDropped_{0};
+};
+} // namespace rosinterface_handler
@@ -0,0 +1,201 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utilities.hpp"
+
+namespace rosinterface_handler {
+/// \brief Compact binary format of parameter values, used by the generated serialize() and deserialize() functions.
+///
+/// Scalars are stored little endian with their fixed size (bool as one byte), strings, vectors and maps with a
+/// uint32_t number of elements in front of the elements. Fixed size types (std::array, Eigen) store only their elements
+/// in row major order. The format does not describe itself, reader and writer have to agree on the types.
+using SerializationBuffer = std::vector<std::uint8_t>;
+
+namespace detail {
+template <std::size_t Size>
+struct UnsignedOfSize {};
+template <>
+struct UnsignedOfSize<1> {
+    using Type = std::uint8_t;
+};
+template <>
+struct UnsignedOfSize<2> {
+    using Type = std::uint16_t;
+};
+template <>
+struct UnsignedOfSize<4> {
+    using Type = std::uint32_t;
+};
+template <>
+struct UnsignedOfSize<8> {
+    using Type = std::uint64_t;
+};
+
+inline void serializeSize(SerializationBuffer& buffer, std::size_t size) {
+    if (size > std::numeric_limits<std::uint32_t>::max()) {
+        rosinterface_handler::exit("RosinterfaceHandler: Value is too large to be serialized.");
+    }
+    const auto size32 = static_cast<std::uint32_t>(size);
+    for (std::size_t i = 0; i < sizeof(size32); ++i) {
+        buffer.push_back(static_cast<std::uint8_t>(size32 >> (8 * i)));
+    }
+}
+} // namespace detail
+
+/// \brief Reads serialized values from a buffer. Reading past the end fails instead of reading garbage.
+class BinaryReader {
+public:
+    BinaryReader(const std::uint8_t* data, std::size_t size) : data_{data}, end_{data + size} {
+    }
+    explicit BinaryReader(const SerializationBuffer& buffer) : BinaryReader(buffer.data(), buffer.size()) {
+    }
+
+    /// \brief Copies the next size bytes to dest. Returns false if there are not enough bytes left.
+    bool read(void* dest, std::size_t size) noexcept {
+        if (remaining() < size) {
+            return false;
+        }
+        std::memcpy(dest, data_, size);
+        data_ += size;
+        return true;
+    }
+
+    /// \brief Returns the next size bytes as string_view. Returns false if there are not enough bytes left.
+    bool read(std::string_view& dest, std::size_t size) noexcept {
+        if (remaining() < size) {
+            return false;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        dest = std::string_view(reinterpret_cast<const char*>(data_), size);
+        data_ += size;
+        return true;
+    }
+
+    std::size_t remaining() const noexcept {
+        return static_cast<std::size_t>(end_ - data_);
+    }
+
+    bool empty() const noexcept {
+        return data_ == end_;
+    }
+
+private:
+    const std::uint8_t* data_;
+    const std::uint8_t* end_;
+};
+
+/// \brief Appends val to buffer
+template <typename T>
+inline void serialize(SerializationBuffer& buffer, const T& val) {
+    if constexpr (std::is_same<T, bool>::value) {
+        buffer.push_back(val ? 1 : 0);
+    } else if constexpr (std::is_arithmetic<T>::value) {
+        using Bits = typename detail::UnsignedOfSize<sizeof(T)>::Type;
+        Bits bits{};
+        std::memcpy(&bits, &val, sizeof(T));
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            buffer.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+        }
+    } else if constexpr (std::is_same<T, InternedString>::value) {
+        serialize(buffer, val.str());
+    } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+        const std::string_view str(val);
+        detail::serializeSize(buffer, str.size());
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    } else if constexpr (detail::FixedSizeParam<T>::value) {
+        for (std::size_t i = 0; i < detail::FixedSizeParam<T>::Size; ++i) {
+            serialize(buffer, detail::FixedSizeParam<T>::at(val, i));
+        }
+    } else if constexpr (detail::IsMapParam<T>::value) {
+        detail::serializeSize(buffer, val.size());
+        for (const auto& elem : val) {
+            serialize(buffer, elem.first);
+            serialize(buffer, elem.second);
+        }
+    } else {
+        static_assert(detail::IsListParam<T>::value, "Type can not be serialized");
+        detail::serializeSize(buffer, val.size());
+        for (const auto& elem : val) {
+            serialize<typename T::value_type>(buffer, elem);
+        }
+    }
+}
+
+/// \brief Reads val from reader
+/// \return false if the data ends early. val is unspecified then.
+template <typename T>
+inline bool deserialize(BinaryReader& reader, T& val) {
+    if constexpr (std::is_same<T, bool>::value) {
+        std::uint8_t byte{};
+        if (!reader.read(&byte, 1) || byte > 1) {
+            return false;
+        }
+        val = byte != 0;
+        return true;
+    } else if constexpr (std::is_arithmetic<T>::value) {
+        using Bits = typename detail::UnsignedOfSize<sizeof(T)>::Type;
+        std::uint8_t bytes[sizeof(T)]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        if (!reader.read(bytes, sizeof(T))) {
+            return false;
+        }
+        Bits bits{0};
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            bits |= static_cast<Bits>(static_cast<Bits>(bytes[i]) << (8 * i)); // NOLINT
+        }
+        std::memcpy(&val, &bits, sizeof(T));
+        return true;
+    } else if constexpr (std::is_same<T, std::string>::value || std::is_same<T, InternedString>::value) {
+        std::uint32_t size{0};
+        std::string_view str;
+        if (!deserialize(reader, size) || !reader.read(str, size)) {
+            return false;
+        }
+        val = T(str);
+        return true;
+    } else if constexpr (detail::FixedSizeParam<T>::value) {
+        for (std::size_t i = 0; i < detail::FixedSizeParam<T>::Size; ++i) {
+            if (!deserialize(reader, detail::FixedSizeParam<T>::at(val, i))) {
+                return false;
+            }
+        }
+        return true;
+    } else {
+        static_assert(detail::IsListParam<T>::value || detail::IsMapParam<T>::value,
+                      "Type can not be deserialized");
+        std::uint32_t size{0};
+        // every element has at least one byte, so a corrupt size can not cause a huge allocation
+        if (!deserialize(reader, size) || size > reader.remaining()) {
+            return false;
+        }
+        if constexpr (detail::IsListParam<T>::value) {
+            T values;
+            values.reserve(size);
+            for (std::uint32_t i = 0; i < size; ++i) {
+                typename T::value_type elem{};
+                if (!deserialize(reader, elem)) {
+                    return false;
+                }
+                values.push_back(std::move(elem));
+            }
+            val = std::move(values);
+        } else {
+            std::vector<std::pair<typename T::key_type, typename T::mapped_type>> values(size);
+            for (auto& elem : values) {
+                if (!deserialize(reader, elem.first) || !deserialize(reader, elem.second)) {
+                    return false;
+                }
+            }
+            val = T(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        }
+        return true;
+    }
+}
+} // namespace rosinterface_handler
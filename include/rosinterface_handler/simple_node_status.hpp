@@ -1,10 +1,16 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <string>
+#include <type_traits>
 #include <diagnostic_updater/diagnostic_updater.h>
 #include <ros/node_handle.h>
 
+#include "diagnostics_hub.hpp"
 #include "utilities.hpp"
 
 namespace rosinterface_handler {
@@ -32,29 +38,70 @@ class SimpleNodeStatus {
     };
 
 public:
+    //! Refers to a status registered with registerStatus
+    struct StatusHandle {
+        std::uint32_t id{0};
+    };
+
+    //! Refers to a metric registered with registerMetric
+    template <typename T>
+    struct MetricHandle {
+        using ValueType = T;
+        std::uint32_t index{0};
+    };
+
+    //! Maximum number of metrics that can be registered per status
+    static constexpr std::size_t MaxMetrics = 32;
+
     SimpleNodeStatus(const std::string& statusDescription, const ros::NodeHandle& privNh,
                      diagnostic_updater::Updater& updater)
             // update() only has an effect every second, we need a slightly higher value to get a guaranteed update
             : updateStatus_{privNh.createTimer(ros::Duration(1.01), [&](const auto& /*s*/) { updater_->update(); })},
-              updater_{&updater} {
-        updater_->add(statusDescription, [this](StatusWrapper& w) { this->getStatus(w); });
+              tasks_{&updater}, updater_{&updater}, name_{statusDescription} {
+        tasks_->add(statusDescription, [this](StatusWrapper& w) { this->getStatus(w); });
         updater_->force_update();
     }
 
+    //! Reports the status via the process wide DiagnosticsHub. No timer is needed, the hub publishes periodically.
+    SimpleNodeStatus(const std::string& statusDescription, HubUpdater& updater)
+            : tasks_{&updater}, hubUpdater_{&updater}, name_{statusDescription} {
+        tasks_->add(statusDescription, [this](StatusWrapper& w) { this->getStatus(w); });
+        hubUpdater_->force_update();
+    }
+
+    SimpleNodeStatus(SimpleNodeStatus&& rhs) noexcept = delete;
+    SimpleNodeStatus& operator=(SimpleNodeStatus&& rhs) noexcept = delete;
+    SimpleNodeStatus(const SimpleNodeStatus& rhs) = delete;
+    SimpleNodeStatus& operator=(const SimpleNodeStatus& rhs) = delete;
+    ~SimpleNodeStatus() {
+        tasks_->removeByName(name_);
+    }
+
     //! Lightweight way to set or report a new status. The status remains until overwritten by a new status.
     template <typename Arg, typename... Args>
     void set(NodeStatus s, const Arg& arg, const Args&... Args_) { // NOLINT
-        bool modified = false;
+        setImpl(Status{s, asString(arg, Args_...)}, 0);
+    }
+
+    //! Registers a status that is reported frequently (e.g. "Running" in every cycle). Setting it via the returned
+    //! handle is cheap: If it is already the current status, set() neither formats nor allocates nor locks.
+    StatusHandle registerStatus(NodeStatus s, const std::string& msg) {
+        std::lock_guard<std::mutex> g{statusMutex_};
+        registeredStatus_.push_back(Status{s, msg});
+        return StatusHandle{static_cast<std::uint32_t>(registeredStatus_.size())};
+    }
+
+    //! Sets a status previously registered with registerStatus
+    void set(StatusHandle handle) {
+        if (handle.id == 0 || currentStatusId_.load(std::memory_order_acquire) == handle.id) {
+            return;
+        }
+        Status newStatus;
         {
             std::lock_guard<std::mutex> g{statusMutex_};
-            Status newStatus{s, asString(arg, Args_...)};
-            modified = status_ != newStatus;
-            status_ = newStatus;
-        }
-        if (s == NodeStatus::ERROR && modified) {
-            // new errors are reported asap
-            updater_->force_update();
+            newStatus = registeredStatus_.at(handle.id - 1);
         }
+        setImpl(std::move(newStatus), handle.id);
     }
 
     //! Add/overwrite extra information about the status in form of key/value pairs. The information will be shared
@@ -76,18 +123,138 @@ public:
         return false;
     }
 
+    //! Registers a numeric metric that is shared along with the node status. Registration should happen once (e.g.
+    //! during initialization), setting the value via the returned handle is then lock and allocation free. The
+    //! value is only converted to a string when the status is actually published.
+    template <typename T>
+    MetricHandle<T> registerMetric(const std::string& name) {
+        static_assert(std::is_arithmetic<T>::value, "Metrics must be numeric types or bool");
+        std::lock_guard<std::mutex> g{statusMutex_};
+        if (numMetrics_ >= MaxMetrics) {
+            rosinterface_handler::exit("Too many metrics registered for status " + name_ + " when adding " + name);
+        }
+        auto& metric = metrics_[numMetrics_];
+        metric.name = name;
+        metric.kind = metricKind<T>();
+        return MetricHandle<T>{static_cast<std::uint32_t>(numMetrics_++)};
+    }
+
+    //! Sets the current value of a metric
+    template <typename T>
+    void metric(MetricHandle<T> handle, typename MetricHandle<T>::ValueType value) {
+        auto& metric = metrics_[handle.index];
+        metric.bits.store(toBits(value), std::memory_order_relaxed);
+        metric.valid.store(true, std::memory_order_release);
+    }
+
+    //! Removes a metric from the status until it is set again
+    template <typename T>
+    void clearMetric(MetricHandle<T> handle) {
+        metrics_[handle.index].valid.store(false, std::memory_order_release);
+    }
+
 private:
+    enum class MetricKind : std::uint8_t { Bool, Signed, Unsigned, Floating };
+
+    struct Metric {
+        std::atomic<std::uint64_t> bits{0};
+        std::atomic<bool> valid{false};
+        MetricKind kind{MetricKind::Floating};
+        std::string name;
+    };
+
+    template <typename T>
+    static constexpr MetricKind metricKind() {
+        if (std::is_same<T, bool>::value) {
+            return MetricKind::Bool;
+        }
+        if (std::is_floating_point<T>::value) {
+            return MetricKind::Floating;
+        }
+        return std::is_signed<T>::value ? MetricKind::Signed : MetricKind::Unsigned;
+    }
+
+    template <typename T>
+    static std::uint64_t toBits(T value) {
+        if constexpr (std::is_floating_point<T>::value) {
+            const auto d = static_cast<double>(value);
+            std::uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            return bits;
+        } else if constexpr (std::is_signed<T>::value) {
+            return static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+        } else {
+            return static_cast<std::uint64_t>(value);
+        }
+    }
+
+    static void addMetric(StatusWrapper& w, const Metric& metric) {
+        const auto bits = metric.bits.load(std::memory_order_relaxed);
+        switch (metric.kind) {
+        case MetricKind::Bool:
+            w.add(metric.name, bits != 0);
+            break;
+        case MetricKind::Signed:
+            w.add(metric.name, static_cast<std::int64_t>(bits));
+            break;
+        case MetricKind::Unsigned:
+            w.add(metric.name, bits);
+            break;
+        case MetricKind::Floating: {
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            w.add(metric.name, d);
+            break;
+        }
+        }
+    }
+
+    void setImpl(Status&& newStatus, std::uint32_t id) {
+        const bool isError = newStatus.s == NodeStatus::ERROR;
+        bool modified = false;
+        {
+            std::lock_guard<std::mutex> g{statusMutex_};
+            modified = status_ != newStatus;
+            status_ = std::move(newStatus);
+            currentStatusId_.store(id, std::memory_order_release);
+        }
+        if (isError && modified) {
+            // new errors are reported asap
+            forceUpdate();
+        }
+    }
+
+    void forceUpdate() {
+        if (hubUpdater_ != nullptr) {
+            hubUpdater_->force_update();
+        } else {
+            updater_->force_update();
+        }
+    }
+
     void getStatus(StatusWrapper& w) const {
         std::lock_guard<std::mutex> g{statusMutex_};
         w.summary(static_cast<std::uint8_t>(status_.s), status_.msg);
         for (const auto& info : extraInfo_) {
             w.add(info.first, info.second);
         }
+        for (std::size_t i = 0; i < numMetrics_; ++i) {
+            if (metrics_[i].valid.load(std::memory_order_acquire)) {
+                addMetric(w, metrics_[i]);
+            }
+        }
     }
     ros::Timer updateStatus_;
-    diagnostic_updater::Updater* updater_;
+    diagnostic_updater::DiagnosticTaskVector* tasks_;
+    diagnostic_updater::Updater* updater_{nullptr};
+    HubUpdater* hubUpdater_{nullptr};
+    std::string name_;
     mutable std::mutex statusMutex_;
     Status status_{NodeStatus::STALE, "Initializing"};
+    std::deque<Status> registeredStatus_;
+    std::atomic<std::uint32_t> currentStatusId_{0};
     std::map<std::string, std::string> extraInfo_;
+    std::array<Metric, MaxMetrics> metrics_;
+    std::size_t numMetrics_{0};
 };
 } // namespace rosinterface_handler
@@ -0,0 +1,141 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace rosinterface_handler {
+
+//! Process wide pool of immutable strings (e.g. topic names). Every distinct string is stored once and never freed,
+//! so the returned references stay valid for the lifetime of the process. Looking up a known string does not allocate.
+//! Because the pool only grows, only intern strings from a small, fixed set (e.g. the values read at startup). Values
+//! that can change arbitrarily at runtime (e.g. from dynamic_reconfigure) must not be pooled.
+class StringPool {
+public:
+    StringPool(StringPool&& rhs) noexcept = delete;
+    StringPool& operator=(StringPool&& rhs) noexcept = delete;
+    StringPool(const StringPool& rhs) = delete;
+    StringPool& operator=(const StringPool& rhs) = delete;
+    ~StringPool() = default;
+
+    //! Returns the pool of this process
+    static StringPool& instance() {
+        // never destroyed, references must be valid until the very end
+        static auto* pool = new StringPool(); // NOLINT(cppcoreguidelines-owning-memory)
+        return *pool;
+    }
+
+    //! Returns the pooled copy of str
+    const std::string& intern(std::string_view str) {
+        {
+            std::shared_lock<std::shared_mutex> lock{mutex_};
+            auto it = strings_.find(str);
+            if (it != strings_.end()) {
+                return *it;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock{mutex_};
+        return *strings_.emplace(str).first;
+    }
+
+    //! Number of strings in the pool
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock{mutex_};
+        return strings_.size();
+    }
+
+private:
+    StringPool() = default;
+
+    std::set<std::string, std::less<>> strings_;
+    mutable std::shared_mutex mutex_;
+};
+
+/// \brief Returns the pooled copy of a string. See StringPool.
+inline const std::string& intern(std::string_view str) {
+    return StringPool::instance().intern(str);
+}
+
+//! Immutable string stored in the StringPool (e.g. a frame id). Copying only copies a pointer and two InternedStrings
+//! are equal if they point to the same pooled string. Only constructing one from a string looks it up in the pool.
+//! Converts implicitly to const std::string&, so it can be used wherever a string is read.
+class InternedString {
+    template <typename S>
+    using EnableIfStringLike = std::enable_if_t<std::is_convertible<const S&, std::string_view>::value &&
+                                                !std::is_same<S, InternedString>::value>;
+
+public:
+    InternedString() : str_{&intern({})} {
+    }
+    InternedString(std::string_view str) : str_{&intern(str)} { // NOLINT(google-explicit-constructor)
+    }
+    InternedString(const std::string& str) : str_{&intern(str)} { // NOLINT(google-explicit-constructor)
+    }
+    InternedString(const char* str) : str_{&intern(str)} { // NOLINT(google-explicit-constructor)
+    }
+
+    const std::string& str() const noexcept {
+        return *str_;
+    }
+    operator const std::string&() const noexcept { // NOLINT(google-explicit-constructor)
+        return *str_;
+    }
+    const char* c_str() const noexcept {
+        return str_->c_str();
+    }
+    std::size_t size() const noexcept {
+        return str_->size();
+    }
+    bool empty() const noexcept {
+        return str_->empty();
+    }
+
+    friend bool operator==(const InternedString& lhs, const InternedString& rhs) noexcept {
+        return lhs.str_ == rhs.str_;
+    }
+    friend bool operator!=(const InternedString& lhs, const InternedString& rhs) noexcept {
+        return lhs.str_ != rhs.str_;
+    }
+    //! Orders by content, so that the order does not depend on the order in which strings were pooled
+    friend bool operator<(const InternedString& lhs, const InternedString& rhs) noexcept {
+        return lhs.str_ != rhs.str_ && *lhs.str_ < *rhs.str_;
+    }
+    //! Compares the content with any other string without putting it into the pool
+    template <typename S, typename = EnableIfStringLike<S>>
+    friend bool operator==(const InternedString& lhs, const S& rhs) {
+        return std::string_view(*lhs.str_) == std::string_view(rhs);
+    }
+    template <typename S, typename = EnableIfStringLike<S>>
+    friend bool operator==(const S& lhs, const InternedString& rhs) {
+        return rhs == lhs;
+    }
+    template <typename S, typename = EnableIfStringLike<S>>
+    friend bool operator!=(const InternedString& lhs, const S& rhs) {
+        return !(lhs == rhs);
+    }
+    template <typename S, typename = EnableIfStringLike<S>>
+    friend bool operator!=(const S& lhs, const InternedString& rhs) {
+        return !(rhs == lhs);
+    }
+    friend std::ostream& operator<<(std::ostream& stream, const InternedString& str) {
+        return stream << *str.str_;
+    }
+
+private:
+    const std::string* str_;
+};
+} // namespace rosinterface_handler
+
+namespace std {
+//! Hashes the pooled address, which is unique for every content
+template <>
+struct hash<rosinterface_handler::InternedString> {
+    std::size_t operator()(const rosinterface_handler::InternedString& str) const noexcept {
+        return std::hash<const std::string*>{}(&str.str());
+    }
+};
+} // namespace std
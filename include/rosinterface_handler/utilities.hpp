@@ -1,12 +1,37 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <limits>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include <ros/node_handle.h>
 #include <ros/param.h>
 #include <ros/this_node.h>
 
+#include "flat_map.hpp"
+#include "string_pool.hpp"
+
+/// \brief Generated interfaces define their member functions in <Name>Interface-inl.h, which is included by
+/// <Name>Interface.h. If ROSINTERFACE_HANDLER_SEPARATE_IMPL is defined, it is not included and the functions are not
+/// inline, so exactly one .cpp file has to include the -inl.h of each interface.
+#ifdef ROSINTERFACE_HANDLER_SEPARATE_IMPL
+#define ROSINTERFACE_HANDLER_IMPL_INLINE
+#else
+#define ROSINTERFACE_HANDLER_IMPL_INLINE inline
+#endif
+
 /// \brief Helper function to test for std::vector
 template <typename T>
 using IsVector = std::is_same<T, std::vector<typename T::value_type, typename T::allocator_type>>;
@@ -27,6 +52,17 @@ std::ostream& operator<<(std::ostream& out, const std::vector<T>& v) {
     return out;
 }
 
+/// \brief Outstream helper for std:array
+template <typename T, std::size_t N>
+std::ostream& operator<<(std::ostream& out, const std::array<T, N>& v) {
+    if (!v.empty()) {
+        out << '[';
+        std::copy(v.begin(), v.end(), std::ostream_iterator<T>(out, ", "));
+        out << "\b\b]";
+    }
+    return out;
+}
+
 /// \brief Outstream helper for std:map
 template <typename T1, typename T2>
 std::ostream& operator<<(std::ostream& stream, const std::map<T1, T2>& map) {
@@ -38,20 +74,43 @@ std::ostream& operator<<(std::ostream& stream, const std::map<T1, T2>& map) {
     return stream;
 }
 
+/// \brief Outstream helper for rosinterface_handler::FlatMap
+template <typename T1, typename T2, typename C>
+std::ostream& operator<<(std::ostream& stream, const rosinterface_handler::FlatMap<T1, T2, C>& map) {
+    stream << '{';
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        stream << (*it).first << " --> " << (*it).second << ", ";
+    }
+    stream << '}';
+    return stream;
+}
+
 namespace rosinterface_handler {
 
+/// \brief Retrieve the node name from a private namespace without allocating (i.e. everything after the last "/")
+///
+/// @param privateNamespace The private namespace (e.g. "/ns/node")
+/// @return node name (e.g. "node"), points into privateNamespace
+inline std::string_view nodeNameOf(std::string_view privateNamespace) {
+    const auto pos = privateNamespace.find_last_of('/');
+    return pos == std::string_view::npos ? privateNamespace : privateNamespace.substr(pos + 1);
+}
+
+/// \brief Retrieve the parent namespace from a namespace without allocating (i.e. everything before the last "/")
+///
+/// @param nameSpace Any namespace (e.g. "/ns/node")
+/// @return parent namespace (e.g. "/ns", or empty, is there is no parent), points into nameSpace
+inline std::string_view parentNamespaceOf(std::string_view nameSpace) {
+    return nameSpace.substr(0, nameSpace.find_last_of('/'));
+}
+
 /// \brief Retrieve node name
 ///
 /// @param privateNodeHandle The private ROS node handle (i.e.
 /// ros::NodeHandle("~") ).
 /// @return node name
 inline std::string getNodeName(const ros::NodeHandle& privateNodeHandle) {
-    std::stringstream tempString(privateNodeHandle.getNamespace());
-    std::string name;
-    while (std::getline(tempString, name, '/')) {
-        ;
-    }
-    return name;
+    return std::string(nodeNameOf(privateNodeHandle.getNamespace()));
 }
 
 /// \brief Retrieve the parent node handle from a node handle
@@ -60,8 +119,7 @@ inline std::string getNodeName(const ros::NodeHandle& privateNodeHandle) {
 /// ros::NodeHandle("~") ).
 /// @return parent namespace (or empty, is there is no parent)
 inline std::string getParentNamespace(const ros::NodeHandle& nodeHandle) {
-    const auto& nameSpace = nodeHandle.getNamespace();
-    return nameSpace.substr(0, nameSpace.find_last_of('/'));
+    return std::string(parentNamespaceOf(nodeHandle.getNamespace()));
 }
 
 /// \brief Sets the logger level according to a standardized parameter name 'verbosity'.
@@ -145,19 +203,173 @@ inline std::string getTopic(const std::string& nameSpace, const std::string& top
     return nameSpace + topic;
 }
 
+/// \brief Same as getTopic, but returns a pooled string (see StringPool)
+/// Repeated calls with the same arguments neither allocate nor copy the result. The pooled string is never freed, so
+/// only use this for topics known at startup, not for topics that are changed at runtime.
+///
+/// @param name_space Parent namespace (with trailing "/")
+/// @param topic Global or local topic
+/// @return name_space + topic or topic if topic is global
+inline const std::string& getTopicInterned(std::string_view nameSpace, std::string_view topic) {
+    if (topic.empty() || topic[0] == '/') {
+        return intern(topic);
+    }
+    std::array<char, 256> buffer;
+    if (nameSpace.size() + topic.size() > buffer.size()) {
+        return intern(std::string(nameSpace).append(topic));
+    }
+    std::memcpy(buffer.data(), nameSpace.data(), nameSpace.size());
+    std::memcpy(buffer.data() + nameSpace.size(), topic.data(), topic.size());
+    return intern(std::string_view(buffer.data(), nameSpace.size() + topic.size()));
+}
+
 /// \brief ExitFunction for rosinterface_handler
 inline void exit(const std::string& msg = "Runtime Error in rosinterface handler.") {
     // std::exit(EXIT_FAILURE);
     throw std::runtime_error(msg);
 }
 
+namespace detail {
+/// \brief Parameter types that are a list of elements (e.g. written as JSON array or serialized as list). Unlike
+/// IsVector, this can be used with any type.
+template <typename T>
+struct IsListParam : std::false_type {};
+template <typename T, typename Alloc>
+struct IsListParam<std::vector<T, Alloc>> : std::true_type {};
+
+/// \brief Parameter types that map keys to values (std::map and FlatMap). Unlike IsMap, this can be used with any type.
+template <typename T>
+struct IsMapParam : std::false_type {};
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct IsMapParam<std::map<Key, T, Compare, Alloc>> : std::true_type {};
+template <typename Key, typename T, typename Compare>
+struct IsMapParam<FlatMap<Key, T, Compare>> : std::true_type {};
+
+/// \brief Describes parameter types whose number of elements is known at compile time (e.g. std::array).
+/// Specializations provide the Scalar type, the number of elements (Size) and access to the elements in row major
+/// order (at). These parameters are read from a list on the parameter server without an intermediate std::vector.
+template <typename T, typename Enable = void>
+struct FixedSizeParam : std::false_type {};
+
+template <typename T, std::size_t N>
+struct FixedSizeParam<std::array<T, N>> : std::true_type {
+    using Scalar = T;
+    static constexpr std::size_t Size = N;
+    static T& at(std::array<T, N>& val, std::size_t i) {
+        return val[i];
+    }
+    static const T& at(const std::array<T, N>& val, std::size_t i) {
+        return val[i];
+    }
+};
+
+/// \brief Converts a single XmlRpc value. Integers are accepted for floating point values.
+/// \return false if the value has a different type
+template <typename T>
+inline bool fromXmlRpc(XmlRpc::XmlRpcValue& xml, T& val) {
+    const auto type = xml.getType();
+    if constexpr (std::is_same<T, bool>::value) {
+        if (type != XmlRpc::XmlRpcValue::TypeBoolean) {
+            return false;
+        }
+        val = static_cast<bool&>(xml);
+    } else if constexpr (std::is_same<T, std::string>::value) {
+        if (type != XmlRpc::XmlRpcValue::TypeString) {
+            return false;
+        }
+        val = static_cast<std::string&>(xml);
+    } else if constexpr (std::is_floating_point<T>::value) {
+        if (type == XmlRpc::XmlRpcValue::TypeDouble) {
+            val = static_cast<T>(static_cast<double&>(xml));
+        } else if (type == XmlRpc::XmlRpcValue::TypeInt) {
+            val = static_cast<T>(static_cast<int&>(xml));
+        } else {
+            return false;
+        }
+    } else {
+        if (type != XmlRpc::XmlRpcValue::TypeInt) {
+            return false;
+        }
+        val = static_cast<T>(static_cast<int&>(xml));
+    }
+    return true;
+}
+
+/// \brief Converts a single value to the closest XmlRpc type
+template <typename T>
+inline XmlRpc::XmlRpcValue toXmlRpc(const T& val) {
+    if constexpr (std::is_same<T, bool>::value || std::is_same<T, std::string>::value) {
+        return XmlRpc::XmlRpcValue(val);
+    } else if constexpr (std::is_floating_point<T>::value) {
+        return XmlRpc::XmlRpcValue(static_cast<double>(val));
+    } else {
+        return XmlRpc::XmlRpcValue(static_cast<int>(val));
+    }
+}
+
+/// \brief Reads a list from the parameter server directly into a fixed size parameter.
+/// val is only modified if the list has the right size and all elements have the right type.
+template <typename T>
+// NOLINTNEXTLINE(readability-function-size)
+inline bool getFixedSizeParam(const std::string& key, T& val) {
+    using Traits = FixedSizeParam<T>;
+    XmlRpc::XmlRpcValue xml;
+    if (!ros::param::get(key, xml)) {
+        return false;
+    }
+    if (xml.getType() != XmlRpc::XmlRpcValue::TypeArray || xml.size() != static_cast<int>(Traits::Size)) {
+        ROS_ERROR_STREAM("Parameter '" << key << "' must be a list of exactly " << Traits::Size << " values.");
+        return false;
+    }
+    T result;
+    for (std::size_t i = 0; i < Traits::Size; ++i) {
+        if (!fromXmlRpc(xml[static_cast<int>(i)], Traits::at(result, i))) {
+            return false;
+        }
+    }
+    val = result;
+    return true;
+}
+
+/// \brief Converts a fixed size parameter to a list (in row major order)
+template <typename T>
+inline XmlRpc::XmlRpcValue toXmlRpcList(const T& val) {
+    using Traits = FixedSizeParam<T>;
+    XmlRpc::XmlRpcValue xml;
+    xml.setSize(static_cast<int>(Traits::Size));
+    for (std::size_t i = 0; i < Traits::Size; ++i) {
+        xml[static_cast<int>(i)] = toXmlRpc(Traits::at(val, i));
+    }
+    return xml;
+}
+} // namespace detail
+
+/// \brief Creates a fixed size parameter from its elements in row major order (used for default values)
+template <typename T>
+inline T fromRowMajor(
+    const std::array<typename detail::FixedSizeParam<T>::Scalar, detail::FixedSizeParam<T>::Size>& values) {
+    T val;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        detail::FixedSizeParam<T>::at(val, i) = values[i];
+    }
+    return val;
+}
+
 /// \brief Set parameter on ROS parameter server
 ///
 /// \param key Parameter name
 /// \param val Parameter value
 template <typename T>
-inline void setParam(const std::string& key, T val) {
-    ros::param::set(key, val);
+inline void setParam(const std::string& key, const T& val) {
+    if constexpr (detail::FixedSizeParam<T>::value) {
+        ros::param::set(key, detail::toXmlRpcList(val));
+    } else if constexpr (IsFlatMap<T>::value) {
+        ros::param::set(key, std::map<typename T::key_type, typename T::mapped_type>(val.begin(), val.end()));
+    } else if constexpr (std::is_same<T, InternedString>::value) {
+        ros::param::set(key, val.str());
+    } else {
+        ros::param::set(key, val);
+    }
 }
 
 /// \brief Set parameter on ROS parameter server (Overload for long, since long cannot be saved to the parameterserver
@@ -174,7 +386,25 @@ inline void setParam(const std::string& key, int64_t val) {
 template <typename T>
 // NOLINTNEXTLINE(readability-function-size)
 inline bool getParamIncludingLong(const std::string& key, T& val) {
-    return ros::param::get(key, val);
+    if constexpr (detail::FixedSizeParam<T>::value) {
+        return detail::getFixedSizeParam(key, val);
+    } else if constexpr (IsFlatMap<T>::value) {
+        std::map<typename T::key_type, typename T::mapped_type> map;
+        if (!ros::param::get(key, map)) {
+            return false;
+        }
+        val = T(map.begin(), map.end());
+        return true;
+    } else if constexpr (std::is_same<T, InternedString>::value) {
+        std::string str;
+        if (!ros::param::get(key, str)) {
+            return false;
+        }
+        val = str;
+        return true;
+    } else {
+        return ros::param::get(key, val);
+    }
 }
 
 /// \brief Get parameter from ROS parameter server (Overload for long, since long cannot be stored in the
@@ -271,6 +501,148 @@ inline bool testConstParam(const std::string& key) {
     return true;
 }
 
+namespace detail {
+/// \brief Type to read a constant from the parameter server (constant strings are std::string_view)
+template <typename T>
+struct ConstParamStorage {
+    using Type = T;
+};
+
+template <>
+struct ConstParamStorage<std::string_view> {
+    using Type = std::string;
+};
+
+template <typename T, std::size_t N>
+struct ConstParamStorage<std::array<T, N>> {
+    using Type = std::array<typename ConstParamStorage<T>::Type, N>;
+};
+
+template <typename T1, typename T2>
+inline bool constParamEqual(const T1& lhs, const T2& rhs) {
+    if constexpr (FixedSizeParam<T1>::value) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    } else {
+        return lhs == rhs;
+    }
+}
+} // namespace detail
+
+/// \brief Tests that a parameter that was fixed at compile time has the same value on the parameter server (if it is
+/// set there at all)
+///
+/// \param key Parameter name
+/// \param value The value the parameter was fixed to
+template <typename T>
+// NOLINTNEXTLINE(readability-function-size)
+inline bool testConstParam(const std::string& key, const T& value) {
+    if (!ros::param::has(key)) {
+        return true;
+    }
+    typename detail::ConstParamStorage<T>::Type serverValue;
+    if (!getParamImpl(key, serverValue) || !detail::constParamEqual(serverValue, value)) {
+        ROS_WARN_STREAM("Parameter '" << key << "' on the parameter server differs from the value " << value
+                                      << " it was fixed to at compile time. The parameter server value is ignored.");
+        return false;
+    }
+    return true;
+}
+
+namespace detail {
+/// \brief Numbers that are clamped in bulk (std::vector<bool> has no contiguous storage)
+template <typename T>
+using IsClampable = std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>;
+
+/// \brief Clamps all values to a lower bound and returns the number of corrected values.
+/// The loop is branch free, so that the compiler can vectorize it (min/max instructions).
+template <typename T>
+inline std::size_t clampMin(T* data, std::size_t size, T min) {
+    std::size_t violations = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const T v = data[i];
+        violations += static_cast<std::size_t>(v < min);
+        data[i] = v < min ? min : v;
+    }
+    return violations;
+}
+
+/// \brief Clamps all values to an upper bound and returns the number of corrected values.
+template <typename T>
+inline std::size_t clampMax(T* data, std::size_t size, T max) {
+    std::size_t violations = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const T v = data[i];
+        violations += static_cast<std::size_t>(v > max);
+        data[i] = v > max ? max : v;
+    }
+    return violations;
+}
+
+#if defined(__SSE2__)
+// Compilers do not vectorize the loops above for floating point values on plain SSE2 (counting needs 64 bit integer
+// compares). max(bound, v)/min(bound, v) return v if v is NaN, as the scalar version does.
+inline std::size_t clampMin(double* data, std::size_t size, double min) {
+    const __m128d bound = _mm_set1_pd(min);
+    std::size_t violations = 0;
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        const __m128d v = _mm_loadu_pd(data + i);
+        const int mask = _mm_movemask_pd(_mm_cmplt_pd(v, bound));
+        violations += static_cast<std::size_t>((mask & 1) + (mask >> 1));
+        _mm_storeu_pd(data + i, _mm_max_pd(bound, v));
+    }
+    return violations + clampMin<double>(data + i, size - i, min);
+}
+
+inline std::size_t clampMax(double* data, std::size_t size, double max) {
+    const __m128d bound = _mm_set1_pd(max);
+    std::size_t violations = 0;
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        const __m128d v = _mm_loadu_pd(data + i);
+        const int mask = _mm_movemask_pd(_mm_cmpgt_pd(v, bound));
+        violations += static_cast<std::size_t>((mask & 1) + (mask >> 1));
+        _mm_storeu_pd(data + i, _mm_min_pd(bound, v));
+    }
+    return violations + clampMax<double>(data + i, size - i, max);
+}
+#endif
+
+/// \brief Clamps the values of a map (std::map or FlatMap) to a lower bound with one warning for all values
+template <typename Map, typename T>
+// NOLINTNEXTLINE(readability-function-size)
+inline void testMapMin(const std::string& key, Map& val, T min) {
+    std::size_t violations = 0;
+    for (auto&& v : val) {
+        if (v.second < min) {
+            v.second = min;
+            ++violations;
+        }
+    }
+    if (violations > 0) {
+        ROS_WARN_STREAM(violations << " of " << val.size() << " values for " << key
+                                   << " are smaller than minimal allowed value. Correcting them to min=" << min);
+    }
+}
+
+/// \brief Clamps the values of a map (std::map or FlatMap) to an upper bound with one warning for all values
+template <typename Map, typename T>
+// NOLINTNEXTLINE(readability-function-size)
+inline void testMapMax(const std::string& key, Map& val, T max) {
+    std::size_t violations = 0;
+    for (auto&& v : val) {
+        if (v.second > max) {
+            v.second = max;
+            ++violations;
+        }
+    }
+    if (violations > 0) {
+        ROS_WARN_STREAM(violations << " of " << val.size() << " values for " << key
+                                   << " are greater than maximal allowed. Correcting them to max=" << max);
+    }
+}
+} // namespace detail
+
 /// \brief Limit parameter to lower bound if parameter is a scalar.
 ///
 /// \param key Parameter name
@@ -292,9 +664,35 @@ inline void testMin(const std::string key, T& val, T min = std::numeric_limits<T
 /// \param val Parameter value
 /// \param min Lower Threshold
 template <typename T>
+// NOLINTNEXTLINE(readability-function-size)
 inline void testMin(const std::string key, std::vector<T>& val, T min = std::numeric_limits<T>::min()) {
-    for (auto& v : val) {
-        testMin(key, v, min);
+    if constexpr (detail::IsClampable<T>::value) {
+        const auto violations = detail::clampMin(val.data(), val.size(), min);
+        if (violations > 0) {
+            ROS_WARN_STREAM(violations << " of " << val.size() << " values for " << key
+                                       << " are smaller than minimal allowed value. Correcting them to min=" << min);
+        }
+    } else {
+        for (auto& v : val) {
+            testMin(key, v, min);
+        }
+    }
+}
+
+/// \brief Limit parameter to lower bound if parameter has a fixed size (e.g. std::array).
+///
+/// \param key Parameter name
+/// \param val Parameter value
+/// \param min Lower Threshold
+template <typename T, typename P, typename = std::enable_if_t<detail::FixedSizeParam<P>::value>>
+// NOLINTNEXTLINE(readability-function-size)
+inline void testMin(const std::string key, P& val, T min) {
+    using Scalar = typename detail::FixedSizeParam<P>::Scalar;
+    static_assert(detail::IsClampable<Scalar>::value, "Only numbers can have a lower bound");
+    const auto violations = detail::clampMin(val.data(), detail::FixedSizeParam<P>::Size, static_cast<Scalar>(min));
+    if (violations > 0) {
+        ROS_WARN_STREAM(violations << " of " << detail::FixedSizeParam<P>::Size << " values for " << key
+                                   << " are smaller than minimal allowed value. Correcting them to min=" << min);
     }
 }
 
@@ -304,10 +702,20 @@ inline void testMin(const std::string key, std::vector<T>& val, T min = std::num
 /// \param val Parameter value
 /// \param min Lower Threshold
 template <typename K, typename T>
+// NOLINTNEXTLINE(readability-function-size)
 inline void testMin(const std::string key, std::map<K, T>& val, T min = std::numeric_limits<T>::min()) {
-    for (auto& v : val) {
-        testMin(key, v.second, min);
-    }
+    detail::testMapMin(key, val, min);
+}
+
+/// \brief Limit parameter to lower bound if parameter is a FlatMap.
+///
+/// \param key Parameter name
+/// \param val Parameter value
+/// \param min Lower Threshold
+template <typename K, typename T>
+// NOLINTNEXTLINE(readability-function-size)
+inline void testMin(const std::string key, FlatMap<K, T>& val, T min = std::numeric_limits<T>::min()) {
+    detail::testMapMin(key, val, min);
 }
 
 /// \brief Limit parameter to upper bound if parameter is a scalar.
@@ -331,9 +739,35 @@ inline void testMax(const std::string key, T& val, T max = std::numeric_limits<T
 /// \param val Parameter value
 /// \param min Lower Threshold
 template <typename T>
+// NOLINTNEXTLINE(readability-function-size)
 inline void testMax(const std::string key, std::vector<T>& val, T max = std::numeric_limits<T>::max()) {
-    for (auto& v : val) {
-        testMax(key, v, max);
+    if constexpr (detail::IsClampable<T>::value) {
+        const auto violations = detail::clampMax(val.data(), val.size(), max);
+        if (violations > 0) {
+            ROS_WARN_STREAM(violations << " of " << val.size() << " values for " << key
+                                       << " are greater than maximal allowed. Correcting them to max=" << max);
+        }
+    } else {
+        for (auto& v : val) {
+            testMax(key, v, max);
+        }
+    }
+}
+
+/// \brief Limit parameter to upper bound if parameter has a fixed size (e.g. std::array).
+///
+/// \param key Parameter name
+/// \param val Parameter value
+/// \param max Upper Threshold
+template <typename T, typename P, typename = std::enable_if_t<detail::FixedSizeParam<P>::value>>
+// NOLINTNEXTLINE(readability-function-size)
+inline void testMax(const std::string key, P& val, T max) {
+    using Scalar = typename detail::FixedSizeParam<P>::Scalar;
+    static_assert(detail::IsClampable<Scalar>::value, "Only numbers can have an upper bound");
+    const auto violations = detail::clampMax(val.data(), detail::FixedSizeParam<P>::Size, static_cast<Scalar>(max));
+    if (violations > 0) {
+        ROS_WARN_STREAM(violations << " of " << detail::FixedSizeParam<P>::Size << " values for " << key
+                                   << " are greater than maximal allowed. Correcting them to max=" << max);
     }
 }
 
@@ -343,12 +777,149 @@ inline void testMax(const std::string key, std::vector<T>& val, T max = std::num
 /// \param val Parameter value
 /// \param min Lower Threshold
 template <typename K, typename T>
+// NOLINTNEXTLINE(readability-function-size)
 inline void testMax(const std::string key, std::map<K, T>& val, T max = std::numeric_limits<T>::max()) {
-    for (auto& v : val) {
-        testMax(key, v.second, max);
-    }
+    detail::testMapMax(key, val, max);
+}
+
+/// \brief Limit parameter to upper bound if parameter is a FlatMap.
+///
+/// \param key Parameter name
+/// \param val Parameter value
+/// \param max Upper Threshold
+template <typename K, typename T>
+// NOLINTNEXTLINE(readability-function-size)
+inline void testMax(const std::string key, FlatMap<K, T>& val, T max = std::numeric_limits<T>::max()) {
+    detail::testMapMax(key, val, max);
 }
 
+/// \brief Concatenates values in a stack buffer. Only spills to the heap for long strings (or if more is reserved).
+/// Strings and numbers are written directly (numbers with std::to_chars, formatted like a default std::ostream
+/// would do). Everything else is formatted by its operator<<, all of it by the same stream. Stream manipulators
+/// (e.g. std::setprecision, std::hex, std::setw) therefore work like with a std::ostream: Once the format of that
+/// stream is no longer the default, all following values are formatted by it.
+class StringBuilder {
+public:
+    /// \brief Makes room for size characters, so that appending them does not reallocate
+    void reserve(std::size_t size) {
+        if (spilled_) {
+            overflow_.reserve(size);
+        } else if (size > buffer_.size()) {
+            spill(size);
+        }
+    }
+
+    void append(std::string_view str) {
+        if (formatted_) {
+            *stream_ << str;
+            return;
+        }
+        if (spilled_ || size_ + str.size() > buffer_.size()) {
+            if (!spilled_) {
+                spill(2 * (size_ + str.size()));
+            }
+            overflow_.append(str.data(), str.size());
+            return;
+        }
+        std::memcpy(buffer_.data() + size_, str.data(), str.size());
+        size_ += str.size();
+    }
+
+    void append(const std::string& str) {
+        append(std::string_view(str));
+    }
+
+    void append(const char* str) {
+        append(std::string_view(str));
+    }
+
+    void append(char* str) {
+        append(std::string_view(str));
+    }
+
+    template <typename T>
+    void append(const T& value) {
+        using Type = std::decay_t<T>;
+        if (formatted_) {
+            stream(value);
+        } else if constexpr (std::is_same<Type, char>::value || std::is_same<Type, signed char>::value ||
+                      std::is_same<Type, unsigned char>::value) {
+            const char c = static_cast<char>(value);
+            append(std::string_view(&c, 1));
+        } else if constexpr (std::is_same<Type, bool>::value) {
+            append(value ? std::string_view("1") : std::string_view("0"));
+        } else if constexpr (std::is_integral<Type>::value) {
+            std::array<char, std::numeric_limits<Type>::digits10 + 3> chars;
+            auto result = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+            append(std::string_view(chars.data(), static_cast<std::size_t>(result.ptr - chars.data())));
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        } else if constexpr (std::is_floating_point<Type>::value) {
+            std::array<char, 32> chars;
+            // same as the default precision of std::ostream
+            auto result =
+                std::to_chars(chars.data(), chars.data() + chars.size(), value, std::chars_format::general, 6);
+            append(std::string_view(chars.data(), static_cast<std::size_t>(result.ptr - chars.data())));
+#endif
+        } else if constexpr (std::is_convertible<const Type&, const std::string&>::value) {
+            append(std::string_view(static_cast<const std::string&>(value)));
+        } else {
+            stream(value);
+            if (hasDefaultFormat(*stream_)) {
+                // move the text to the buffer, so that the following values can be written directly again
+                const std::string text = stream_->str();
+                stream_->str({});
+                append(std::string_view(text));
+            } else {
+                formatted_ = true;
+            }
+        }
+    }
+
+    std::string str() const& {
+        std::string result = spilled_ ? overflow_ : std::string(buffer_.data(), size_);
+        if (formatted_) {
+            result += stream_->str();
+        }
+        return result;
+    }
+
+    std::string str() && {
+        std::string result = spilled_ ? std::move(overflow_) : std::string(buffer_.data(), size_);
+        if (formatted_) {
+            result += stream_->str();
+        }
+        return result;
+    }
+
+private:
+    template <typename T>
+    void stream(const T& value) {
+        using ::operator<<;
+        if (!stream_) {
+            stream_ = std::make_unique<std::ostringstream>();
+        }
+        *stream_ << value;
+    }
+
+    static bool hasDefaultFormat(const std::ostream& os) {
+        return os.flags() == (std::ios_base::skipws | std::ios_base::dec) && os.precision() == 6 &&
+               os.width() == 0 && os.fill() == ' ';
+    }
+
+    void spill(std::size_t capacity) {
+        overflow_.reserve(capacity);
+        overflow_.assign(buffer_.data(), size_);
+        spilled_ = true;
+    }
+
+    std::array<char, 256> buffer_;
+    std::size_t size_{0};
+    std::string overflow_;
+    bool spilled_{false};
+    std::unique_ptr<std::ostringstream> stream_; //!< only created for values that are not written directly
+    bool formatted_{false};                      //!< true if all values are written to stream_
+};
+
 /// \brief Convert at least one argument to a string
 /// \tparam Arg Type of required argument
 /// \tparam Args Type of additional arguments (optional)
@@ -357,10 +928,10 @@ inline void testMax(const std::string key, std::map<K, T>& val, T max = std::num
 /// \return
 template <typename Arg, typename... Args>
 inline std::string asString(Arg&& arg, Args&&... Args_) { // NOLINT
-    std::ostringstream oss;
-    oss << std::forward<Arg>(arg);
-    (oss << ... << std::forward<Args>(Args_));
-    return oss.str();
+    StringBuilder builder;
+    builder.append(arg);
+    (builder.append(Args_), ...);
+    return std::move(builder).str();
 }
 
 inline std::string asString(std::string&& arg) {
@@ -371,4 +942,33 @@ inline const std::string& asString(const std::string& arg) {
     return arg;
 }
 
+namespace detail {
+template <typename... Args>
+struct StreamedArgs {
+    std::tuple<const Args&...> args;
+
+    // hidden friend, so that it does not hide the global operator<< of containers from unqualified lookup
+    friend std::ostream& operator<<(std::ostream& os, const StreamedArgs& streamed) {
+        std::apply(
+            [&os](const auto&... args) {
+                using ::operator<<;
+                (os << ... << args);
+            },
+            streamed.args);
+        return os;
+    }
+};
+} // namespace detail
+
+/// \brief Defers formatting of the arguments until the result is written to a stream
+/// Nothing is formatted if the result is never streamed (e.g. because the log level is disabled or the message is
+/// throttled). The arguments are streamed directly, without building an intermediate string. The returned object
+/// references the arguments and must not outlive them.
+/// \param args Arguments to stream
+/// \return an object that streams all arguments when written to a std::ostream
+template <typename... Args>
+inline detail::StreamedArgs<Args...> streamed(const Args&... args) {
+    return detail::StreamedArgs<Args...>{std::tie(args...)};
+}
+
 } // namespace rosinterface_handler
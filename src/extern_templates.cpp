@@ -0,0 +1,6 @@
+// Explicit instantiations of the subscriber and publisher templates that are declared extern in
+// rosinterface_handler/extern_templates.hpp
+#include <rosinterface_handler/extern_templates.hpp>
+
+ROSINTERFACE_HANDLER_INSTANTIATE_SUBSCRIBER(, std_msgs::Header)
+ROSINTERFACE_HANDLER_FOR_COMMON_MESSAGES(ROSINTERFACE_HANDLER_INSTANTIATE_DIAGNOSED, )
@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""
+Generates the interface files of several .rosif files in one Python process, instead of starting an interpreter (and
+importing the generator) for every file. Called by generate_ros_interface_files() if
+ROSINTERFACE_HANDLER_BATCH_GENERATION is on:
+
+python -m rosinterface_handler.batch_generator <rosinterface_handler root> <share dir> <include dir> <python dir>
+    --stamp-dir=<dir> [--specialization-dir=<dir>] [--cache-dir=<dir>] [--profile] <file.rosif>...
+
+Every .rosif is executed as if it was called directly. A .rosif is skipped if its stamp file (<stamp dir>/<name>.stamp)
+is newer than the .rosif, the templates, the generator and its specialization file, so that only changed files are
+generated again.
+If a cache dir is given, the generator stores the model of every .rosif there. A .rosif that has to be generated again
+although neither its content nor the generator changed (e.g. only a template or its specialization changed, or it was
+only touched) is then generated from the cached model instead of executing it again.
+"""
+from __future__ import print_function
+import glob
+import os
+import runpy
+import sys
+
+from rosinterface_handler.interface_generator_catkin import InterfaceGenerator
+
+
+def newest_dependency(rosif, root_dir, specialization):
+    """
+    Returns the newest modification time of everything the generated files of rosif depend on
+    """
+    dependencies = [rosif, os.path.join(os.path.dirname(os.path.abspath(__file__)), "interface_generator_catkin.py")]
+    dependencies += glob.glob(os.path.join(root_dir, "templates", "*.template"))
+    if specialization:
+        dependencies.append(specialization)
+    return max(os.path.getmtime(f) for f in dependencies)
+
+
+def generate(rosif, generator_args, stamp, specialization):
+    """
+    Executes rosif like the generate_ros_interface_files() macro would do without batch mode. Uses the cached model
+    instead, if there is a valid one.
+    :return: Exit code of the .rosif
+    """
+    sys.argv = [rosif] + generator_args + ["--stamp=" + stamp]
+    if specialization:
+        sys.argv.append(specialization)
+    try:
+        gen = InterfaceGenerator.load_cached(rosif)
+        if gen:
+            return gen.generate(gen.pkgname, gen.nodename, gen.classname)
+        runpy.run_path(rosif, run_name="__main__")
+    except SystemExit as e:
+        if e.code:
+            return e.code if isinstance(e.code, int) else 1
+    return 0
+
+
+def main(argv):
+    args = [arg for arg in argv if not arg.startswith("--")]
+    options = dict(arg[2:].split("=", 1) for arg in argv if arg.startswith("--") and "=" in arg)
+    if len(args) < 4 or "stamp-dir" not in options:
+        sys.exit("Usage: python -m rosinterface_handler.batch_generator <root dir> <share dir> <include dir> "
+                 "<python dir> --stamp-dir=<dir> [--specialization-dir=<dir>] [--cache-dir=<dir>] [--profile] "
+                 "<file.rosif>...")
+    generator_args = args[:4]
+    if "cache-dir" in options:
+        generator_args.append("--cache-dir=" + options["cache-dir"])
+    if "--profile" in argv:
+        generator_args.append("--profile")
+    root_dir = args[0]
+    stamp_dir = options["stamp-dir"]
+    specialization_dir = options.get("specialization-dir")
+
+    generated = 0
+    for rosif in args[4:]:
+        name = os.path.splitext(os.path.basename(rosif))[0]
+        stamp = os.path.join(stamp_dir, name + ".stamp")
+        specialization = None
+        if specialization_dir and os.path.exists(os.path.join(specialization_dir, name + ".yaml")):
+            specialization = os.path.join(specialization_dir, name + ".yaml")
+        if os.path.exists(stamp) and \
+                os.path.getmtime(stamp) >= newest_dependency(rosif, root_dir, specialization):
+            continue
+        result = generate(rosif, generator_args, stamp, specialization)
+        if result:
+            print("Generating interface files from {} failed".format(rosif), file=sys.stderr)
+            return result
+        generated += 1
+    print("Generated interface files from {} of {} files".format(generated, len(args) - 4))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
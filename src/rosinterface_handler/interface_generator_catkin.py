@@ -27,11 +27,14 @@
 #
 
 from __future__ import print_function
-from string import Template
+from string import Template as StringTemplate
 import sys
 import os
 import re
+import hashlib
+import pickle
 import subprocess
+import time
 
 
 def eprint(*args, **kwargs):
@@ -42,13 +45,117 @@ def eprint(*args, **kwargs):
     sys.exit(1)
 
 
+def write_if_changed(filename, content):
+    """
+    Writes content to filename, unless the file already has exactly this content. Keeping the file untouched keeps its
+    modification time, so that build systems do not rebuild everything that depends on it.
+    :param filename: File to write, missing directories are created
+    :param content: The new content
+    :return: True if the file was written
+    """
+    try:
+        with open(filename, 'r') as f:
+            if f.read() == content:
+                return False
+    except (IOError, OSError):
+        pass
+    try:
+        if not os.path.exists(os.path.dirname(filename)):
+            os.makedirs(os.path.dirname(filename))
+    except OSError:
+        # Stupid error, sometimes the directory exists anyway
+        pass
+    with open(filename, 'w') as f:
+        f.write(content)
+    return True
+
+
+def model_key(rosif):
+    """
+    Returns the key under which the model of a .rosif is cached. It changes whenever the .rosif or the generator (which
+    performs the checks and builds the model) changes. The templates are not part of it, they are applied to the model.
+    :param rosif: Path of the .rosif file
+    :return: Hex digest
+    """
+    generator = os.path.splitext(os.path.abspath(__file__))[0] + ".py"
+    key = hashlib.sha1("python{}".format(sys.version_info[0]).encode('utf-8'))
+    for filename in (rosif, generator):
+        with open(filename, 'rb') as f:
+            key.update(f.read())
+    return key.hexdigest()
+
+
+class Template(object):
+    """
+    Drop-in replacement for string.Template that parses every template only once. A template is split into text and
+    placeholders when it is seen for the first time and cached, so creating the same template again (e.g. for every
+    parameter) costs a lookup and substitute() renders it in a single pass by joining the parts.
+    """
+    _cache = {}
+
+    def __new__(cls, template):
+        compiled = cls._cache.get(template)
+        if compiled is None:
+            compiled = cls._cache[template] = super(Template, cls).__new__(cls)
+            compiled._compile(template)
+        return compiled
+
+    def _compile(self, template):
+        # text and placeholder names alternately, starting and ending with text
+        self.parts = []
+        text = []
+        last = 0
+        for match in StringTemplate.pattern.finditer(template):
+            text.append(template[last:match.start()])
+            last = match.end()
+            if match.group('escaped') is not None:
+                text.append(StringTemplate.delimiter)
+            elif match.group('named') or match.group('braced'):
+                self.parts.append("".join(text))
+                self.parts.append(match.group('named') or match.group('braced'))
+                text = []
+            else:
+                raise ValueError("Invalid placeholder in template: {}".format(template[match.start():].split()[0]))
+        text.append(template[last:])
+        self.parts.append("".join(text))
+
+    def substitute(self, **mapping):
+        parts = list(self.parts)
+        for i in range(1, len(parts), 2):
+            parts[i] = str(mapping[parts[i]])
+        return "".join(parts)
+
+
+_template_files = {}
+
+
+def template_file(filename):
+    """
+    Returns the Template in a template file. Every file is only read once per process.
+    """
+    template = _template_files.get(filename)
+    if template is None:
+        with open(filename, 'r') as f:
+            template = _template_files[filename] = Template(f.read())
+    return template
+
+
 class InterfaceGenerator(object):
     """Automatic config file and header generator"""
 
+    # attributes that describe the current run, not the interface. They are not stored in the model cache.
+    _runtime_attributes = ("dynconfpath", "share_dir", "cpp_gen_dir", "py_gen_dir", "specialization_file",
+                           "stamp_file", "cache_dir", "profile", "generated_files", "stage_times", "start_time",
+                           "from_cache")
+
     def __init__(self, parent=None, group=""):
         """Constructor for InterfaceGenerator"""
+        self.start_time = time.time()
+        self.stage_times = []
+        self.from_cache = False
         self.enums = []
         self.parameters = []
+        self.parameter_names = set()
         self.subscribers = []
         self.publishers = []
         self.childs = []
@@ -57,19 +164,43 @@ class InterfaceGenerator(object):
         self.parent = parent
         self.diagnostics_enabled = False
         self.simplified_diagnostics = False
+        self.diagnostics_hub = False
+        self.async_logging = False
+        self.constant_traits = False
+        self.config_snapshot = None
         if group:
             self.group = group
         else:
             self.group = "gen"
         self.group_variable = "".join(filter(str.isalnum, self.group))
 
-        if len(sys.argv) != 5:
+        if len(sys.argv) < 5:
             eprint("InterfaceGenerator: Unexpected arguments, did you call this directly? You shouldn't do this!")
 
         self.dynconfpath = sys.argv[1]
         self.share_dir = sys.argv[2]
         self.cpp_gen_dir = sys.argv[3]
         self.py_gen_dir = sys.argv[4]
+        # optional yaml file with parameter values that are folded into constants (see _apply_specialization)
+        self.specialization_file = None
+        # optional file that is updated on every run and holds a hash of the generated files (see _write_stamp)
+        self.stamp_file = None
+        # optional directory where the parsed model is cached for the batch generator (see load_cached)
+        self.cache_dir = None
+        # print the time spent in every generation stage
+        self.profile = False
+        for arg in sys.argv[5:]:
+            if arg.startswith("--stamp="):
+                self.stamp_file = arg[len("--stamp="):]
+            elif arg.startswith("--cache-dir="):
+                self.cache_dir = arg[len("--cache-dir="):]
+            elif arg == "--profile":
+                self.profile = True
+            elif self.specialization_file is None:
+                self.specialization_file = arg
+            else:
+                eprint("InterfaceGenerator: Unexpected arguments, did you call this directly? You shouldn't do this!")
+        self.generated_files = []
 
         self.pkgname = None
         self.nodename = None
@@ -98,19 +229,61 @@ class InterfaceGenerator(object):
         else:
             self.add(name, description='Sets the verbosity for this node', paramtype='std::string', default=default)
 
-    def add_diagnostic_updater(self, simplified_status=False):
+    def add_diagnostic_updater(self, simplified_status=False, use_hub=False):
         """
         Adds a diagnostic updater to the interface struct. Make sure your project depends on the diagnostic_updater
         package. Must be called before adding any diagnostic-enabled publishers/subscribers.
-        Unless simplified_status is true, the node must ensure to regularly call interface.updater.update().
+        Unless simplified_status or use_hub is true, the node must ensure to regularly call interface.updater.update().
         :param simplified_status: Enables simplified status updates,
         e.g. interface.nodeStatus.set(NodeStatus::Error, "something is wrong");
+        :param use_hub: Registers the updater at the process wide rosinterface_handler::DiagnosticsHub. All interfaces
+        of a process (e.g. all nodelets in a manager) are then published as one DiagnosticArray from a single thread.
+        Not yet supported for python (the flag is ignored).
         :return:
         """
         if self.parent:
             eprint("You can't call add_diagnostic_updater on a group! Call it on the main parameter generator instead!")
         self.diagnostics_enabled = True
         self.simplified_diagnostics = simplified_status
+        self.diagnostics_hub = use_hub
+
+    def add_async_logging(self):
+        """
+        Prints the messages of the log functions of the interface (logInfo, logWarn, ...) on a background thread, so
+        that logging never blocks. Messages are dropped if they are logged faster than they can be printed. If a
+        diagnostic updater is added, dropped messages are reported as diagnostic status "logging".
+        Not yet supported for python (the flag is ignored).
+        :return:
+        """
+        if self.parent:
+            eprint("You can't call add_async_logging on a group! Call it on the main parameter generator instead!")
+        self.async_logging = True
+
+    def add_config_snapshot(self, topic="config_snapshot"):
+        """
+        Publishes the values of all parameters on a latched std_msgs/UInt8MultiArray topic, so that the configuration
+        can be recorded in a rosbag. fromParamServer() and fromConfig() publish a snapshot of all values, but only if
+        a value changed (see rosinterface_handler/config_snapshot.hpp). Use applyConfigSnapshot() to read them.
+        Make sure your project depends on the std_msgs package. Not yet supported for python (the flag is ignored).
+        :param topic: Topic name, relative to the private namespace of the node
+        :return:
+        """
+        if self.parent:
+            eprint("You can't call add_config_snapshot on a group! Call it on the main parameter generator instead!")
+        self.config_snapshot = topic
+
+    def add_constant_traits(self):
+        """
+        Adds the struct ConstantTraits to the interface. It holds every integral or bool constant parameter as
+        std::integral_constant (e.g. MyInterface::ConstantTraits::window_size), so that code can be specialized on
+        them at compile time (tag dispatch, template arguments, ...). The constants themselves are constexpr members of
+        the interface and can be used in constant expressions anyway.
+        Not supported for python (the flag is ignored).
+        :return:
+        """
+        if self.parent:
+            eprint("You can't call add_constant_traits on a group! Call it on the main parameter generator instead!")
+        self.constant_traits = True
 
     def add_tf(self, buffer_name="tf_buffer", listener_name="tf_listener", broadcaster_name=None):
         """
@@ -369,18 +542,21 @@ class InterfaceGenerator(object):
         return newparam
 
     def add(self, name, paramtype, description, level=0, edit_method='""', default=None, min=None, max=None,
-            configurable=False, global_scope=False, constant=False):
+            configurable=False, global_scope=False, constant=False, flat_map=False,
+            interned=False):
         """
         Add parameters to your parameter struct. Call this method from your .params file!
 
         - If no default value is given, you need to specify one in your launch file
-        - Global parameters, vectors, maps and constant params can not be configurable
+        - Global parameters, vectors, maps, fixed size types and constant params can not be configurable
         - Global parameters, vectors and maps can not have a default, min or max value
+        - Fixed size types (std::array<T, N>, Eigen::Matrix<T, Rows, Cols>, Eigen::Vector3d, ...) are read from a list
+          of exactly N (Rows * Cols) values. Matrices are listed in row major order.
 
         :param self:
         :param name: The Name of you new parameter
         :param paramtype: The C++ type of this parameter. Can be any of ['std::string', 'int', 'bool', 'float',
-        'double'] or std::vector<...> or std::map<std::string, ...>
+        'double'] or std::vector<...>, std::map<std::string, ...>, std::array<..., N> or a fixed size Eigen matrix
         :param description: Choose an informative documentation string for this parameter.
         :param level: (optional) Passed to dynamic_reconfigure
         :param edit_method: (optional) Passed to dynamic_reconfigure
@@ -391,12 +567,20 @@ class InterfaceGenerator(object):
         :param global_scope: (optional) If true, parameter is searched in global ('/') namespace instead of private (
         '~') ns
         :param constant: (optional) If this is true, the parameter will not be fetched from param server,
-        but the default value is kept.
+        but the default value is kept. Constants are constexpr members. Strings become std::string_view, vectors and
+        arrays become std::array. Maps and Eigen types can not be constant.
+        :param flat_map: (optional) Only for std::map<...>. Generates a rosinterface_handler::FlatMap (sorted vector)
+        instead, which is faster to look up and allocation free for lookups with std::string_view or string literals.
+        :param interned: (optional) Only for std::string. Generates a rosinterface_handler::InternedString instead,
+        which is cheap to copy and compare (e.g. for frame ids that are copied into every message). Interned strings
+        are never freed, so they can not be configurable.
         :return: None
         """
         configurable = self._make_bool(configurable)
         global_scope = self._make_bool(global_scope)
         constant = self._make_bool(constant)
+        flat_map = self._make_bool(flat_map)
+        interned = self._make_bool(interned)
         newparam = {
             'name': name,
             'type': paramtype,
@@ -408,8 +592,14 @@ class InterfaceGenerator(object):
             'max': max,
             'is_vector': False,
             'is_map': False,
+            'is_array': False,
+            'array_size': None,
+            'element_type': None,
+            'flat_map': flat_map,
+            'interned': interned,
             'configurable': configurable,
             'constant': constant,
+            'specialized': False,
             'global_scope': global_scope,
         }
         self._perform_checks(newparam)
@@ -418,6 +608,7 @@ class InterfaceGenerator(object):
             self.parameters.insert(0, newparam)
         else:
             self.parameters.append(newparam)
+        self.parameter_names.add(name)
 
     def _perform_checks(self, param):
         """
@@ -437,6 +628,8 @@ class InterfaceGenerator(object):
             param['is_vector'] = True
         if in_type.startswith('std::map'):
             param['is_map'] = True
+        if in_type.startswith('std::array') or in_type.startswith('Eigen::'):
+            self._parse_fixed_size_type(param, in_type)
 
         if (param['is_vector']):
             if (param['max'] is not None or param['min'] is not None):
@@ -460,15 +653,28 @@ class InterfaceGenerator(object):
             eprint(param['name'], "The name of field does not follow the ROS naming conventions, "
                                   "see http://wiki.ros.org/ROS/Patterns/Conventions")
         if param['configurable'] and (
-            param['global_scope'] or param['is_vector'] or param['is_map'] or (
+            param['global_scope'] or param['is_vector'] or param['is_map'] or param['is_array'] or (
                 in_type == "int64_t") or param['constant']):
             eprint(param['name'],
-                   "Global parameters, vectors, maps, long and constant params can not be declared configurable! ")
+                   "Global parameters, vectors, maps, fixed size types, long and constant params can not be declared "
+                   "configurable! ")
         if param['global_scope'] and param['default'] is not None:
             eprint(param['name'], "Default values for global parameters should not be specified in node! ")
         if param['constant'] and param['default'] is None:
             eprint(param['name'], "Constant parameters need a default value!")
-        if param['name'] in [p['name'] for p in self.parameters]:
+        if param['flat_map'] and not param['is_map']:
+            eprint(param['name'], "Only std::map<...> can be generated as flat map")
+        if param['interned'] and param['type'] != 'std::string':
+            eprint(param['name'], "Only std::string can be generated as interned string")
+        if param['interned'] and param['configurable']:
+            eprint(param['name'], "Interned strings are never freed and can not be declared configurable!")
+        if param['constant']:
+            self._check_constant(param)
+        if param['is_array'] and param['default'] is not None and (
+                not isinstance(param['default'], list) or len(param['default']) != param['array_size']):
+            eprint(param['name'],
+                   "The default value of %s must be a list of %d values" % (in_type, param['array_size']))
+        if param['name'] in self.parameter_names:
             eprint(param['name'], "Parameter with the same name exists already")
         if param['edit_method'] == '':
             param['edit_method'] = '""'
@@ -493,11 +699,138 @@ class InterfaceGenerator(object):
             self._test_primitive_type(param['name'], ptype[0])
             self._test_primitive_type(param['name'], ptype[1])
             param['type'] = 'std::map<{},{}>'.format(ptype[0], ptype[1])
+        elif param['is_array']:
+            self._test_primitive_type(param['name'], param['element_type'])
         else:
             # Pytype and defaults can only be applied to primitives
             self._test_primitive_type(param['name'], in_type)
             param['pytype'] = self._pytype(in_type)
 
+    @staticmethod
+    def _parse_fixed_size_type(param, in_type):
+        """
+        Sets element type and size of std::array<T, N>, Eigen::Matrix<T, Rows, Cols> and the Eigen typedefs (e.g.
+        Eigen::Matrix3d, Eigen::Vector2f, Eigen::RowVector4i)
+        :param param: Dictionary of one param
+        :param in_type: Typestring
+        :return:
+        """
+        std_array = re.match(r'^std::array<\s*([\w:]+)\s*,\s*(\d+)\s*>$', in_type)
+        eigen_matrix = re.match(r'^Eigen::Matrix<\s*(\w+)\s*,\s*(\d+)\s*,\s*(\d+)\s*>$', in_type)
+        eigen_typedef = re.match(r'^Eigen::(Matrix|Vector|RowVector)([2-4])([dfi])$', in_type)
+        eigen_scalars = {'d': 'double', 'f': 'float', 'i': 'int'}
+        if std_array:
+            element_type, size = std_array.group(1), int(std_array.group(2))
+            param['type'] = 'std::array<{},{}>'.format(element_type, size)
+        elif eigen_matrix:
+            element_type, size = eigen_matrix.group(1), int(eigen_matrix.group(2)) * int(eigen_matrix.group(3))
+            param['type'] = 'Eigen::Matrix<{},{},{}>'.format(element_type, eigen_matrix.group(2),
+                                                              eigen_matrix.group(3))
+        elif eigen_typedef:
+            element_type = eigen_scalars[eigen_typedef.group(3)]
+            dim = int(eigen_typedef.group(2))
+            size = dim * dim if eigen_typedef.group(1) == 'Matrix' else dim
+            param['type'] = in_type
+        else:
+            eprint(param['name'], "Unsupported fixed size type %s. Use std::array<T, N>, Eigen::Matrix<T, Rows, Cols> "
+                                  "or a fixed size Eigen typedef (e.g. Eigen::Vector3d)" % in_type)
+        if size == 0:
+            eprint(param['name'], "Fixed size types must have at least one element")
+        if in_type.startswith('Eigen::') and element_type not in eigen_scalars.values():
+            eprint(param['name'], "Eigen types must have one of %s as scalar" % list(eigen_scalars.values()))
+        if element_type == 'int64_t':
+            eprint(param['name'], "Fixed size types of int64_t are not supported")
+        has_limits = param['max'] is not None or param['min'] is not None
+        if element_type in ['std::string', 'bool'] and has_limits:
+            eprint(param['name'], "Max and min can not be specified for variable of type %s" % in_type)
+        param['is_array'] = True
+        param['is_eigen'] = in_type.startswith('Eigen::')
+        param['element_type'] = element_type
+        param['array_size'] = size
+
+    @staticmethod
+    def _get_cpptype(param):
+        """
+        Returns the C++ type of the parameter's member (the type of flat maps and interned strings differs from
+        param['type'])
+        :param param: Dictionary of one param
+        :return: C++ type
+        """
+        if param['flat_map']:
+            return 'rosinterface_handler::FlatMap<{}>'.format(param['type'][9:-1])
+        if param['interned']:
+            return 'rosinterface_handler::InternedString'
+        return param['type']
+
+    @staticmethod
+    def _check_constant(param):
+        """
+        Tests whether a parameter can be a constant and whether its value is valid.
+        :param param: Dictionary of one param
+        :return:
+        """
+        if param['is_map'] or (param['is_array'] and param['is_eigen']):
+            eprint(param['name'], "Maps and Eigen types can not be constant!")
+        if param['default'] is None:
+            return
+        if param['is_array'] and (not isinstance(param['default'], list) or
+                                  len(param['default']) != param['array_size']):
+            eprint(param['name'], "The value of %s must be a list of %d values" % (param['type'], param['array_size']))
+        if param['is_vector'] and not isinstance(param['default'], list):
+            eprint(param['name'], "The value of %s must be a list" % param['type'])
+        # constants are not clamped, they must be valid already
+        values = param['default'] if isinstance(param['default'], list) else [param['default']]
+        if (param['min'] is not None and any(v < param['min'] for v in values)) or (
+                param['max'] is not None and any(v > param['max'] for v in values)):
+            eprint(param['name'], "The value of a constant parameter must be within min and max")
+
+    def _apply_specialization(self):
+        """
+        Folds parameters into constants for a specialized build. The values are read from the yaml file passed as
+        optional last argument to the generator (same format as written by _generateyml/generate_yaml). Parameters
+        without a value in the file are not touched. fromParamServer() only warns if the parameter server disagrees.
+        :return:
+        """
+        if not self.specialization_file:
+            return
+        import yaml
+        with open(self.specialization_file, 'r') as f:
+            values = yaml.safe_load(f) or {}
+        params = {param['name']: param for param in self._get_parameters()}
+        for name, value in values.items():
+            if value is None:
+                continue
+            if name not in params:
+                eprint(name, "%s sets a parameter that does not exist" % self.specialization_file)
+            param = params[name]
+            if param['configurable'] or param['global_scope']:
+                eprint(name, "Configurable and global parameters can not be specialized")
+            if param['constant']:
+                continue
+            param['default'] = value
+            param['constant'] = True
+            param['specialized'] = True
+            self._check_constant(param)
+        if self.profile:
+            print("Specialized {} parameters with {}".format(sum(p['specialized'] for p in params.values()),
+                                                             self.specialization_file))
+
+    def _get_constexpr(self, param):
+        """
+        Helper function to declare a constant parameter as literal type
+        :param param: Dictionary of one param
+        :return: C++ type and initializer of the constexpr member
+        """
+        if param['is_vector'] or param['is_array']:
+            element_type = param['element_type'] if param['is_array'] else param['type'][12:-1].strip()
+            if element_type == 'std::string':
+                element_type = 'std::string_view'
+            ctype = 'std::array<{},{}>'.format(element_type, len(param['default']))
+            return ctype, '{{{}}}'.format(self._get_cvaluelist(param, 'default'))
+        if param['type'] == 'std::string':
+            return 'std::string_view', self._get_cvalue(param, 'default')
+        return param['type'], self._get_cvalue(param, 'default')
+
     @staticmethod
     def _pytype(drtype):
         """Convert C++ type to python type"""
@@ -560,11 +893,12 @@ class InterfaceGenerator(object):
         """
         values = param[field]
         assert (isinstance(values, list))
+        element_type = param['element_type'] if param['is_array'] else param['type'][12:-1].strip()
         form = ""
         for value in values:
-            if param['type'] == 'std::vector<std::string>':
+            if element_type == 'std::string':
                 value = '"{}"'.format(value)
-            elif param['type'] == 'std::vector<bool>':
+            elif element_type == 'bool':
                 value = str(value).lower()
             else:
                 value = str(value)
@@ -611,16 +945,95 @@ class InterfaceGenerator(object):
         if self.parent:
             eprint("You should not call generate on a group! Call it on the main parameter generator instead!")
 
-        return self._generateImpl()
+        # everything up to here happened while executing the .rosif (adding and checking the parameters)
+        if self.from_cache:
+            self.stage_times.append(("cached definition", time.time() - self.start_time))
+        else:
+            self.stage_times.append(("definition", time.time() - self.start_time))
+            self._timed("cache", self._save_model)
+        self._timed("specialization", self._apply_specialization)
+        result = self._generateImpl()
+        self._timed("stamp", self._write_stamp)
+        self._print_profile()
+        return result
+
+    @classmethod
+    def load_cached(cls, rosif):
+        """
+        Restores the generator of rosif from the model cache (--cache-dir), without executing the .rosif again. Uses the
+        arguments in sys.argv, like the constructor does. Call generate(gen.pkgname, gen.nodename, gen.classname) on the
+        result to generate the files.
+        :param rosif: Path of the .rosif file
+        :return: The generator or None if there is no valid cached model
+        """
+        start_time = time.time()
+        gen = cls()
+        if not gen.cache_dir:
+            return None
+        try:
+            with open(gen._cache_file(rosif), 'rb') as f:
+                cached = pickle.load(f)
+        except Exception:  # a missing or unreadable cache is just a cache miss
+            return None
+        if cached.get("key") != model_key(rosif) or cached.get("class") is not cls:
+            return None
+        gen.__dict__.update(cached["model"])
+        for child in gen.childs:
+            child.parent = gen
+        gen.start_time = start_time
+        gen.from_cache = True
+        return gen
+
+    def _cache_file(self, rosif):
+        return os.path.join(self.cache_dir, os.path.splitext(os.path.basename(rosif))[0] + ".model")
+
+    def _save_model(self):
+        """
+        Stores the parameters, subscribers and publishers as they were defined in the .rosif (before specialization) in
+        the model cache, if a cache directory was passed.
+        :return:
+        """
+        rosif = sys.argv[0]
+        if not self.cache_dir or not os.path.isfile(rosif):
+            return
+        model = {k: v for k, v in self.__dict__.items() if k not in self._runtime_attributes}
+        content = pickle.dumps({"key": model_key(rosif), "class": type(self), "model": model}, pickle.HIGHEST_PROTOCOL)
+        try:
+            if not os.path.exists(self.cache_dir):
+                os.makedirs(self.cache_dir)
+        except OSError:
+            # Stupid error, sometimes the directory exists anyway
+            pass
+        with open(self._cache_file(rosif), 'wb') as f:
+            f.write(content)
+
+    def _timed(self, stage, function):
+        """
+        Calls function and remembers how long it took for the profile
+        :param stage: Name of the stage in the profile
+        :param function: Function to call
+        :return: Result of function
+        """
+        start_time = time.time()
+        result = function()
+        self.stage_times.append((stage, time.time() - start_time))
+        return result
+
+    def _print_profile(self):
+        if not self.profile:
+            return
+        stages = ", ".join("{} {:.1f} ms".format(stage, t * 1000.) for stage, t in self.stage_times)
+        total = sum(t for _, t in self.stage_times)
+        print("Generation profile of {}: {} (total {:.1f} ms)".format(self.classname, stages, total * 1000.))
 
     def _generateImpl(self):
         """
         Implementation level function. Can be overwritten by derived classes.
         :return:
         """
-        self._generatecfg()
-        self._generatehpp()
-        self._generatepy()
+        self._timed("cfg", self._generatecfg)
+        self._timed("hpp", self._generatehpp)
+        self._timed("py", self._generatepy)
 
         return 0
 
@@ -631,27 +1044,17 @@ class InterfaceGenerator(object):
         :return:
         """
         templatefile = os.path.join(self.dynconfpath, "templates", "ConfigType.h.template")
-        with open(templatefile, 'r') as f:
-            template = f.read()
-
         param_entries = self._generate_param_entries()
 
         param_entries = "\n".join(param_entries)
-        template = Template(template).substitute(pkgname=self.pkgname, nodename=self.nodename,
-                                                 classname=self.classname, params=param_entries)
+        template = template_file(templatefile).substitute(pkgname=self.pkgname, nodename=self.nodename,
+                                                          classname=self.classname, params=param_entries)
 
         cfg_file = os.path.join(self.share_dir, "cfg", self.classname + ".cfg")
-        try:
-            if not os.path.exists(os.path.dirname(cfg_file)):
-                os.makedirs(os.path.dirname(cfg_file))
-        except OSError:
-            # Stupid error, sometimes the directory exists anyway
-            pass
-        with open(cfg_file, 'w') as f:
-            f.write(template)
-        os.chmod(cfg_file, 509)  # entspricht 775 (octal)
-        # calling sync mitigate issues in docker (see https://github.com/moby/moby/issues/9547)
-        subprocess.check_call(["sync", "-f", cfg_file])
+        if self._write_generated(cfg_file, template):
+            os.chmod(cfg_file, 509)  # entspricht 775 (octal)
+            # calling sync mitigate issues in docker (see https://github.com/moby/moby/issues/9547)
+            subprocess.check_call(["sync", "-f", cfg_file])
 
     def _generatehpp(self):
         """
@@ -661,13 +1064,12 @@ class InterfaceGenerator(object):
         """
 
         # Read in template file
-        templatefile = os.path.join(self.dynconfpath, "templates", "Interface.h.template")
-        with open(templatefile, 'r') as f:
-            template = f.read()
-
         substitutions = {"pkgname": self.pkgname, "ClassName": self.classname, "nodename": self.nodename}
         param_entries = []
+        member_entries = []
         string_representation = []
+        json_representation = []
+        parameter_labels = []
         from_server = []
         to_server = []
         non_default_params = []
@@ -676,6 +1078,8 @@ class InterfaceGenerator(object):
         includes = []
         sub_adv_from_server = []
         sub_adv_from_config = []
+        sub_adv_from_values = []
+        update_topics = []
         subscriber_entries = []
         subscribers_init = []
         publisher_entries = []
@@ -692,35 +1096,61 @@ class InterfaceGenerator(object):
 
         if any(subscriber["watch"] for subscriber in subscribers):
             includes.append('#include <rosinterface_handler/smart_subscriber.hpp>')
+        if subscribers or publishers:
+            # declares the templates of rosinterface_handler_templates extern, if that library is used
+            includes.append('#include <rosinterface_handler/extern_templates.hpp>')
 
+        substitutions["asyncLogging"] = "true" if self.async_logging else "false"
         substitutions["includeDiagnosticUpdaterError"] = ""
         if self.diagnostics_enabled:
-            param_entries.append('  diagnostic_updater::Updater updater; /*!< Manages diagnostics of this node */')
-            subscribers_init.append(',\n    updater{ros::NodeHandle(), private_node_handle, nodeNameWithNamespace()}')
+            if self.diagnostics_hub:
+                member_entries.append(
+                    '  rosinterface_handler::HubUpdater updater; /*!< Manages diagnostics of this node */')
+                includes.append('#include <rosinterface_handler/diagnostics_hub.hpp>')
+                subscribers_init.append(',\n    updater{nodeNameWithNamespace()}')
+            else:
+                member_entries.append('  diagnostic_updater::Updater updater; /*!< Manages diagnostics of this node */')
+                subscribers_init.append(
+                    ',\n    updater{ros::NodeHandle(), private_node_handle, nodeNameWithNamespace()}')
             includes.append('#include <rosinterface_handler/diagnostic_subscriber.hpp>')
             from_server.append('    updater.setHardwareID("none");')
             if self.simplified_diagnostics:
-                param_entries.append(
+                member_entries.append(
                     '  rosinterface_handler::SimpleNodeStatus nodeStatus; /*!< Reports the status of this node */')
-                subscribers_init.append(',\n    nodeStatus{"status", private_node_handle, updater}')
+                if self.diagnostics_hub:
+                    subscribers_init.append(',\n    nodeStatus{"status", updater}')
+                else:
+                    subscribers_init.append(',\n    nodeStatus{"status", private_node_handle, updater}')
                 includes.append('#include <rosinterface_handler/simple_node_status.hpp>')
+            if self.async_logging:
+                member_entries.append(
+                    '  rosinterface_handler::LoggerStatus loggerStatus; /*!< Reports dropped log messages */')
+                subscribers_init.append(',\n    loggerStatus{"logging", logger(), updater}')
+                includes.append('#include <rosinterface_handler/logger_status.hpp>')
             substitutions["includeDiagnosticUpdaterError"] = "#error diagnostic_updater is missing as dependency."
 
+        if self.config_snapshot:
+            includes.append('#include <rosinterface_handler/config_snapshot.hpp>')
+            member_entries.append('  rosinterface_handler::ConfigSnapshot configSnapshot; /*!< Publishes the parameter '
+                                  'values */')
+            subscribers_init.append(',\n    configSnapshot{{private_node_handle, "{}"}}'.format(self.config_snapshot))
+
         if self.tf:
             listener = self.tf["listener_name"]
             buffer = self.tf["buffer_name"]
             broadcaster = self.tf["broadcaster_name"]
             if buffer:
                 includes.append('#include <tf2_ros/buffer.h>')
-                param_entries.append('  tf2_ros::Buffer {};'.format(buffer))
+                member_entries.append('  tf2_ros::Buffer {};'.format(buffer))
             if listener:
                 includes.append('#include <tf2_ros/transform_listener.h>')
-                param_entries.append('  tf2_ros::TransformListener {};'.format(listener))
+                member_entries.append('  tf2_ros::TransformListener {};'.format(listener))
                 subscribers_init.append(',\n    {}{{{}}}'.format(listener, buffer))
             if broadcaster:
                 includes.append('#include <tf2_ros/transform_broadcaster.h>')
-                param_entries.append('  tf2_ros::TransformBroadcaster {};'.format(broadcaster))
+                member_entries.append('  tf2_ros::TransformBroadcaster {};'.format(broadcaster))
 
+        constant_params = set(param['name'] for param in self._get_parameters() if param['constant'])
         first = True
         for subscriber in subscribers:
             name = subscriber['name']
@@ -763,8 +1193,8 @@ class InterfaceGenerator(object):
             # add printing
             space = "" if first else '", " +'
             first = False
-            print_subscribed.append(Template('      message += $space $name->getTopic();').substitute(name=name,
-                                                                                                      space=space))
+            print_subscribed.append(Template('    message += $space $name->getTopic();').substitute(name=name,
+                                                                                                    space=space))
 
             # add subscribe for parameter server
             topic_param = subscriber['topic_param']
@@ -790,30 +1220,33 @@ class InterfaceGenerator(object):
             sub_adv_from_server.append(
                 Template(
                     '    $name->subscribe(privateNodeHandle_, '
-                    'rosinterface_handler::getTopic($namespace, $topic), uint32_t($queue)$noDelay);') .substitute(
+                    'rosinterface_handler::getTopicInterned($namespace, $topic), '
+                    'uint32_t($queue)$noDelay);') .substitute(
                     name=name,
                     topic=topic_param,
                     queue=queue_size_param,
                     noDelay=no_delay,
                     namespace=name_space))
+            # apply changed values from dynamic_reconfigure (config) and from applyParameters() (values)
+            # topics from constant parameters can not change
+            sources = [] if {topic_param, queue_size_param} & constant_params else [('values', sub_adv_from_values)]
             if subscriber['configurable']:
+                sources.append(('config', sub_adv_from_config))
+            for src, sub_adv in sources:
                 if diagnosed:
-                    sub_adv_from_config.append(
-                        Template(
-                            '    $name->minFrequency(config.$minFParam)'
-                            '.maxTimeDelay(config.$maxTParam);') .substitute(
-                            name=name,
-                            minFParam=min_freq_param,
-                            maxTParam=max_delay_param))
-                sub_adv_from_config.append(Template('    if($topic != config.$topic || $queue != config.$queue) {\n'
-                                                    '      $name->subscribe(privateNodeHandle_, '
-                                                    'rosinterface_handler::getTopic($namespace, config.$topic), '
-                                                    'uint32_t(config.$queue)$noDelay);\n'
-                                                    '    }').substitute(name=name, topic=topic_param,
-                                                                        queue=queue_size_param, noDelay=no_delay,
-                                                                        namespace=name_space))
-                if watch:
-                    from_config.append(Template('    $name->updateTopics();').substitute(name=name))
+                    sub_adv.append(Template('    $name->minFrequency($src.$minFParam).maxTimeDelay($src.$maxTParam);')
+                                   .substitute(name=name, src=src, minFParam=min_freq_param, maxTParam=max_delay_param))
+                sub_adv.append(Template('    if(this->$topic != $src.$topic || this->$queue != $src.$queue) {\n'
+                                        '      $name->subscribe(privateNodeHandle_, '
+                                        'rosinterface_handler::getTopic('
+                                        '$namespace, $src.$topic), uint32_t($src.$queue)$noDelay);\n'
+                                        '    }').substitute(name=name, src=src, topic=topic_param,
+                                                            queue=queue_size_param, noDelay=no_delay,
+                                                            namespace=name_space))
+            if watch:
+                update_topics.append(Template('    $name->updateTopics();').substitute(name=name))
+                if subscriber['configurable']:
+                    from_config.append(update_topics[-1])
                     test_limits.append(from_config[-1])
 
         first = True
@@ -844,8 +1277,8 @@ class InterfaceGenerator(object):
             # add printing
             space = "" if first else '", " +'
             first = False
-            print_advertised.append(Template('      message += $space $name.getTopic();').substitute(name=name,
-                                                                                                     space=space))
+            print_advertised.append(Template('    message += $space $name.getTopic();').substitute(name=name,
+                                                                                                   space=space))
 
             # add advertise for parameter server
             topic_param = publisher['topic_param']
@@ -865,25 +1298,22 @@ class InterfaceGenerator(object):
                 sub_adv_from_server.append(Template('    $name.minFrequency($minFParam).maxTimeDelay($maxTParam);')
                                            .substitute(name=name, minFParam=min_freq_param, maxTParam=max_delay_param))
             sub_adv_from_server.append(Template('    $name = privateNodeHandle_.advertise<$type>('
-                                                'rosinterface_handler::getTopic($namespace, $topic), $queue);')
+                                                'rosinterface_handler::getTopicInterned($namespace, $topic), $queue);')
                                        .substitute(name=name, type=type, topic=topic_param, queue=queue_size_param,
                                                    namespace=name_space))
+            sources = [] if {topic_param, queue_size_param} & constant_params else [('values', sub_adv_from_values)]
             if publisher['configurable']:
+                sources.append(('config', sub_adv_from_config))
+            for src, sub_adv in sources:
                 if diagnosed:
-                    sub_adv_from_config.append(
-                        Template(
-                            '    $name.minFrequency(config.$minFParam)'
-                            '.maxTimeDelay(config.$maxTParam);') .substitute(
-                            name=name,
-                            minFParam=min_freq_param,
-                            maxTParam=max_delay_param))
-                sub_adv_from_config.append(Template('    if($topic != config.$topic || $queue != config.$queue) {\n'
-                                                    '      $name = privateNodeHandle_.advertise<$type>('
-                                                    'rosinterface_handler::getTopic($namespace, config.$topic), '
-                                                    'config.$queue);\n'
-                                                    '    }').substitute(name=name, type=type, topic=topic_param,
-                                                                        queue=queue_size_param,
-                                                                        namespace=name_space))
+                    sub_adv.append(Template('    $name.minFrequency($src.$minFParam).maxTimeDelay($src.$maxTParam);')
+                                   .substitute(name=name, src=src, minFParam=min_freq_param, maxTParam=max_delay_param))
+                sub_adv.append(Template('    if(this->$topic != $src.$topic || this->$queue != $src.$queue) {\n'
+                                        '      $name = privateNodeHandle_.advertise<$type>('
+                                        'rosinterface_handler::getTopic('
+                                        '$namespace, $src.$topic), $src.$queue);\n'
+                                        '    }').substitute(name=name, src=src, type=type, topic=topic_param,
+                                                            queue=queue_size_param, namespace=name_space))
         substitutions["includes"] = "\n".join(includes)
         substitutions["subscribers"] = "\n".join(subscriber_entries)
         substitutions["publishers"] = "\n".join(publisher_entries)
@@ -894,6 +1324,10 @@ class InterfaceGenerator(object):
         substitutions["initSubscribers"] = "".join(subscribers_init)
 
         params = self._get_parameters()
+        constant_traits = []
+        serialize = []
+        deserialize = []
+        serialization_layout = hashlib.sha1()
 
         # Create dynamic parts of the header file for every parameter
         for param in params:
@@ -915,29 +1349,44 @@ class InterfaceGenerator(object):
             else:
                 if param['is_vector']:
                     default = ', {}'.format(str(param['type']) + "{" + self._get_cvaluelist(param, "default") + "}")
+                elif param['is_array']:
+                    default = ', rosinterface_handler::fromRowMajor<{}>({{{}}})'.format(
+                        param['type'], self._get_cvaluelist(param, "default"))
                 elif param['is_map']:
-                    default = ', {}'.format(str(param['type']) + "{" + self._get_cvaluedict(param, "default") + "}")
+                    default = ', {}{{{}}}'.format(self._get_cpptype(param), self._get_cvaluedict(param, "default"))
                 else:
-                    default = ', {}'.format(str(param['type']) + "{" + self._get_cvalue(param, "default") + "}")
+                    default = ', {}'.format(self._get_cpptype(param) + "{" + self._get_cvalue(param, "default") + "}")
 
             # Test for constant value
             if param['constant']:
-                param_entries.append(Template('  static constexpr auto ${name} = $default; /*!< ${description} '
-                                              '*/').substitute(type=param['type'], name=name,
+                ctype, cvalue = self._get_constexpr(param)
+                param_entries.append(Template('  static constexpr ${type} ${name}{$default}; /*!< ${description} '
+                                              '*/').substitute(type=ctype, name=name,
                                                                description=param['description'],
-                                                               default=self._get_cvalue(param, "default")))
-                from_server.append(
-                    Template('    rosinterface_handler::testConstParam($paramname);').substitute(
-                        paramname=full_name))
+                                                               default=cvalue))
+                if param['type'] in ['int', 'bool', 'int64_t']:
+                    constant_traits.append(Template('    using ${name} = std::integral_constant<${type}, ${value}>;')
+                                           .substitute(name=name, type=param['type'], value=cvalue))
+                if param['specialized']:
+                    from_server.append(
+                        Template('    rosinterface_handler::testConstParam($paramname, $name);').substitute(
+                            paramname=full_name, name=name))
+                else:
+                    from_server.append(
+                        Template('    rosinterface_handler::testConstParam($paramname);').substitute(
+                            paramname=full_name))
             else:
                 param_entries.append(Template('  ${type} ${name}; /*!< ${description} */').substitute(
-                    type=param['type'], name=name, description=param['description']))
+                    type=self._get_cpptype(param), name=name, description=param['description']))
                 from_server.append(Template('    success &= rosinterface_handler::getParam($paramname, $name$default);')
                                    .substitute(paramname=full_name, name=name,
                                                default=default, description=param['description']))
                 to_server.append(
                     Template('    rosinterface_handler::setParam(${paramname},${name});').substitute(
                         paramname=full_name, name=name))
+                serialize.append('    rosinterface_handler::serialize(buffer, this->{});'.format(name))
+                deserialize.append('    success &= rosinterface_handler::deserialize(reader, values.{});'.format(name))
+                serialization_layout.update('{} {};'.format(self._get_cpptype(param), name).encode('utf-8'))
 
             # Test for configurable params
             if param['configurable']:
@@ -948,20 +1397,28 @@ class InterfaceGenerator(object):
                 ttype = param['type'][12:-1].strip()
             elif param['is_map']:
                 ttype = param['type'][9:-1].strip()
+            elif param['is_array']:
+                ttype = param['element_type']
             else:
                 ttype = param['type']
-            if param['min'] is not None:
+            if param['min'] is not None and not param['constant']:
                 test_limits.append(
                     Template('    rosinterface_handler::testMin<$type>($paramname, $name, $min);').substitute(
                         paramname=full_name, name=name, min=param['min'], type=ttype))
-            if param['max'] is not None:
+            if param['max'] is not None and not param['constant']:
                 test_limits.append(
                     Template('    rosinterface_handler::testMax<$type>($paramname, $name, $max);').substitute(
                         paramname=full_name, name=name, max=param['max'], type=ttype))
 
             # Add debug output
-            string_representation.append(Template('      << "\t" << p.$namespace << "$name:" << p.$name << '
-                                                  '"\\n"\n').substitute(namespace=namespace, name=name))
+            string_representation.append(Template('    out.append(parameterLabels_[$index]);\n'
+                                                  '    out.append(this->$name);\n'
+                                                  "    out.append('\\n');").substitute(
+                index=len(parameter_labels), name=name))
+            parameter_labels.append('"\\t" + {} + "{}:"'.format(namespace, name))
+            json_representation.append(Template('    out.append("$separator\\"$name\\":");\n'
+                                                '    rosinterface_handler::appendJson(out, this->$name);').substitute(
+                separator="," if json_representation else "", name=name))
 
             # handle verbosity param
             if self.verbosity == name:
@@ -976,25 +1433,74 @@ class InterfaceGenerator(object):
                         '    }').substitute(
                         verbosity=self.verbosity)
                     from_config.insert(0, verb_check)
-
+                if not param['constant']:
+                    sub_adv_from_values.insert(0, Template(
+                        '    if(values.$verbosity != this->$verbosity) {\n'
+                        '        rosinterface_handler::setParam(privateNamespace_ + "$verbosity", values.$verbosity);\n'
+                        '        rosinterface_handler::setLoggerLevel(privateNodeHandle_, "$verbosity", '
+                        'nodeNameWithNamespace());\n'
+                        '    }').substitute(verbosity=self.verbosity))
+
+        if self.constant_traits:
+            param_entries.insert(0, '  /// \\brief Integral constant parameters as types\n'
+                                    '  struct ConstantTraits {\n' + "".join(t + '\n' for t in constant_traits) + '  };')
         substitutions["parameters"] = "\n".join(param_entries)
-        substitutions["string_representation"] = "".join(string_representation)
+        substitutions["members"] = "\n".join(member_entries)
+        substitutions["string_representation"] = "\n".join(string_representation)
+        substitutions["json_representation"] = "\n".join(json_representation)
+        substitutions["parameterLabels"] = (",\n" + " " * 22).join(parameter_labels)
+        substitutions["parameterCount"] = len(parameter_labels)
         substitutions["non_default_params"] = "".join(non_default_params)
         substitutions["fromParamServer"] = "\n".join(from_server)
         substitutions["toParamServer"] = "\n".join(to_server)
         substitutions["fromConfig"] = "\n".join(from_config)
         substitutions["test_limits"] = "\n".join(test_limits)
-        content = Template(template).substitute(**substitutions)
-
-        header_file = os.path.join(self.cpp_gen_dir, self.classname + "Interface.h")
-        try:
-            if not os.path.exists(os.path.dirname(header_file)):
-                os.makedirs(os.path.dirname(header_file))
-        except OSError:
-            # Stupid error, sometimes the directory exists anyway
-            pass
-        with open(header_file, 'w') as f:
-            f.write(content)
+        substitutions["subscribeAdvertiseFromValues"] = "\n".join(sub_adv_from_values + update_topics)
+        substitutions["serialize"] = "\n".join(serialize)
+        substitutions["deserialize"] = "\n".join(deserialize)
+        substitutions["serializationLayout"] = "0x{}u".format(serialization_layout.hexdigest()[:8])
+        substitutions["configSnapshotDeclarations"] = ""
+        substitutions["configSnapshotDefinitions"] = ""
+        substitutions["publishConfigSnapshot"] = ""
+        if self.config_snapshot:
+            substitutions["configSnapshotDeclarations"] = \
+                '\n  /// \\brief Publishes the parameters on the config snapshot topic, if they changed. Called by\n' \
+                '  /// fromParamServer(), fromConfig() and deserialize().\n' \
+                '  void publishConfigSnapshot();\n\n' \
+                '  /// \\brief Sets the parameters to the values of a message on the config snapshot topic.\n' \
+                '  /// Every message contains all values, so any message can be applied on its own.\n' \
+                '  ///\n' \
+                '  /// \\return false if the message is invalid or was published by an interface with other\n' \
+                '  /// parameters. No parameter is changed then.\n' \
+                '  bool applyConfigSnapshot(const std_msgs::UInt8MultiArray& msg);'
+            substitutions["configSnapshotDefinitions"] = Template(
+                '\nROSINTERFACE_HANDLER_IMPL_INLINE void ${ClassName}Interface::publishConfigSnapshot() {\n'
+                '    rosinterface_handler::SerializationBuffer buffer;\n'
+                '    serialize(buffer);\n'
+                '    configSnapshot.publish(std::move(buffer));\n'
+                '}\n\n'
+                'ROSINTERFACE_HANDLER_IMPL_INLINE bool ${ClassName}Interface::applyConfigSnapshot(\n'
+                '    const std_msgs::UInt8MultiArray& msg) {\n'
+                '    return rosinterface_handler::ConfigSnapshot::isSnapshot(msg) && deserialize(msg.data);\n'
+                '}\n').substitute(ClassName=self.classname)
+            substitutions["publishConfigSnapshot"] = "    publishConfigSnapshot();"
+        if any(param['is_array'] and param['is_eigen'] for param in params):
+            substitutions["parameterIncludes"] = "#include <rosinterface_handler/eigen_utilities.hpp>"
+            substitutions["typeIncludes"] = "#include <Eigen/Core>"
+        else:
+            substitutions["parameterIncludes"] = ""
+            substitutions["typeIncludes"] = ""
+
+        # The interface is split, so that code that only needs the parameter values does not include all of ROS:
+        # Fwd: forward declarations, Parameters: the values, Interface: the interface, -inl: its member functions
+        for template_name, header_name in [("InterfaceFwd.h.template", "InterfaceFwd.h"),
+                                           ("Parameters.h.template", "Parameters.h"),
+                                           ("Interface.h.template", "Interface.h"),
+                                           ("Interface-inl.h.template", "Interface-inl.h")]:
+            templatefile = os.path.join(self.dynconfpath, "templates", template_name)
+            content = template_file(templatefile).substitute(**substitutions)
+            header_file = os.path.join(self.cpp_gen_dir, self.classname + header_name)
+            self._write_generated(header_file, content)
 
     def _generatepy(self):
         """
@@ -1021,34 +1527,54 @@ class InterfaceGenerator(object):
         if self.simplified_diagnostics:
             imports.add("import rospy")
             imports.add("import diagnostic_msgs")
-        imports = "\n".join(imports)
+        imports = "\n".join(sorted(imports))
 
         # Read in template file
         templatefile = os.path.join(self.dynconfpath, "templates", "Interface.py.template")
-        with open(templatefile, 'r') as f:
-            template = f.read()
-
-        content = Template(template).substitute(pkgname=self.pkgname, ClassName=self.classname, imports=imports,
-                                                paramDescription=paramDescription,
-                                                subscriberDescription=subscriberDescription,
-                                                publisherDescription=publisherDescription,
-                                                verbosityParam=verbosityParam,
-                                                tfConfig=self.tf,
-                                                diagnosticsEnabled=self.diagnostics_enabled,
-                                                simplifiedDiagnostics=self.simplified_diagnostics)
+        content = template_file(templatefile).substitute(pkgname=self.pkgname, ClassName=self.classname,
+                                                         imports=imports,
+                                                         paramDescription=paramDescription,
+                                                         subscriberDescription=subscriberDescription,
+                                                         publisherDescription=publisherDescription,
+                                                         verbosityParam=verbosityParam,
+                                                         tfConfig=self.tf,
+                                                         diagnosticsEnabled=self.diagnostics_enabled,
+                                                         simplifiedDiagnostics=self.simplified_diagnostics)
 
         py_file = os.path.join(self.py_gen_dir, "interface", self.classname + "Interface.py")
+        self._write_generated(py_file, content)
+        init_file = os.path.join(self.py_gen_dir, "interface", "__init__.py")
+        if not os.path.exists(init_file):
+            write_if_changed(init_file, "")
+
+    def _write_generated(self, filename, content):
+        """
+        Writes a generated file if its content changed and remembers its content for the stamp file
+        :param filename: Generated file
+        :param content: Content of the file
+        :return: True if the file was written
+        """
+        data = content if isinstance(content, bytes) else content.encode('utf-8')
+        self.generated_files.append((filename, hashlib.sha1(data).hexdigest()))
+        return write_if_changed(filename, content)
+
+    def _write_stamp(self):
+        """
+        Writes the stamp file (if requested) with the hashes of all generated files. Unlike the generated files, it is
+        written on every run, so that the build system knows that the generator does not have to run again.
+        :return:
+        """
+        if not self.stamp_file:
+            return
+        content = "".join("{}  {}\n".format(digest, filename) for filename, digest in self.generated_files)
         try:
-            if not os.path.exists(os.path.dirname(py_file)):
-                os.makedirs(os.path.dirname(py_file))
+            if not os.path.exists(os.path.dirname(self.stamp_file)):
+                os.makedirs(os.path.dirname(self.stamp_file))
         except OSError:
             # Stupid error, sometimes the directory exists anyway
             pass
-        with open(py_file, 'w') as f:
+        with open(self.stamp_file, 'w') as f:
             f.write(content)
-        init_file = os.path.join(self.py_gen_dir, "interface", "__init__.py")
-        with open(init_file, 'w') as f:
-            f.write("")
 
     def _generateyml(self):
         """
@@ -1182,5 +1708,5 @@ class InterfaceGenerator(object):
 # Create derived class for yaml generation
 class YamlGenerator(InterfaceGenerator):
     def _generateImpl(self):
-        self._generateyml()
+        self._timed("yml", self._generateyml)
         return 0
@@ -0,0 +1,46 @@
+#include <sstream>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <rosinterface_handler/utilities.hpp>
+
+namespace {
+// The former implementation of asString
+template <typename Arg, typename... Args>
+std::string asStringStream(const Arg& arg, const Args&... args) {
+    std::ostringstream oss;
+    ((oss << arg) << ... << args);
+    return oss.str();
+}
+} // namespace
+
+static void statusMessageStream(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(asStringStream("Received ", ++i, " messages at ", 9.81, " Hz"));
+    }
+}
+BENCHMARK(statusMessageStream);
+
+static void statusMessage(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rosinterface_handler::asString("Received ", ++i, " messages at ", 9.81, " Hz"));
+    }
+}
+BENCHMARK(statusMessage);
+
+static void singleNumberStream(benchmark::State& state) {
+    double d = 0.;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(asStringStream(d += 0.1));
+    }
+}
+BENCHMARK(singleNumberStream);
+
+static void singleNumber(benchmark::State& state) {
+    double d = 0.;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rosinterface_handler::asString(d += 0.1));
+    }
+}
+BENCHMARK(singleNumber);
@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <rosinterface_handler/flat_map.hpp>
+
+namespace {
+// e.g. thresholds per object class, looked up for every detection. The keys are too long for the small string
+// optimization, so std::map allocates when looking up a string literal.
+std::vector<std::string> makeKeys(std::size_t size) {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < size; ++i) {
+        keys.push_back("detection_object_class_" + std::to_string(i));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+    return keys;
+}
+
+template <typename Map>
+Map makeMap(const std::vector<std::string>& keys) {
+    Map map;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        map.insert({keys[i], 0.1 * static_cast<double>(i)});
+    }
+    return map;
+}
+
+template <typename Map>
+void lookup(benchmark::State& state) {
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    const auto map = makeMap<Map>(keys);
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            benchmark::DoNotOptimize(map.find(key)->second);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void lookupLiteral(benchmark::State& state) {
+    const auto map = makeMap<Map>(makeKeys(static_cast<std::size_t>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find("detection_object_class_1"));
+    }
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(lookup, std::map<std::string, double>)->Range(8, 512);
+BENCHMARK_TEMPLATE(lookup, rosinterface_handler::FlatMap<std::string, double>)->Range(8, 512);
+BENCHMARK_TEMPLATE(lookupLiteral, std::map<std::string, double>)->Range(8, 512);
+BENCHMARK_TEMPLATE(lookupLiteral, rosinterface_handler::FlatMap<std::string, double>)->Range(8, 512);
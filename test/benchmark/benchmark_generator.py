@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""
+Benchmark of the interface generator on a synthetic .rosif with many parameters. It is not run as part of the tests:
+
+python test/benchmark/benchmark_generator.py [--parameters=1000] [--repetitions=10]
+
+Generates the interface of the synthetic .rosif into a temporary directory several times (in one process, like the batch
+generator does) and prints the fastest and the median run and the time per generation stage of the fastest run.
+"""
+from __future__ import print_function
+import os
+import runpy
+import shutil
+import sys
+import tempfile
+import time
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "../../src")
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "../..")
+
+
+def synthetic_rosif(parameters):
+    """
+    Returns a .rosif with the given number of parameters of all kinds and a subscriber and publisher per 20 parameters
+    """
+    lines = ["import sys",
+             "sys.path.append({!r})".format(SRC_DIR),
+             "from rosinterface_handler.interface_generator_catkin import *",
+             "gen = InterfaceGenerator()",
+             "gen.add_verbosity_param(configurable=True)",
+             "gen.add_diagnostic_updater()"]
+    kinds = ['gen.add("int_param_{0}", paramtype="int", description="An int", default={0}, min=0, max=100000, '
+             'configurable=True)',
+             'gen.add("double_param_{0}", paramtype="double", description="A double", default={0}.5)',
+             'gen.add("str_param_{0}", paramtype="std::string", description="A string", default="value {0}", '
+             'configurable=True)',
+             'gen.add("bool_param_{0}", paramtype="bool", description="A global bool", global_scope=True)',
+             'gen.add("vector_param_{0}", paramtype="std::vector<double>", description="A vector", default=[1.0, {0}])',
+             'gen.add("map_param_{0}", paramtype="std::map<std::string,int>", description="A map", default={{"a": {0}}})',
+             'gen.add("missing_param_{0}", paramtype="int", description="Without default")',
+             'gen.add("constant_param_{0}", paramtype="int", description="A constant", default={0}, constant=True)']
+    for i in range(parameters):
+        lines.append(kinds[i % len(kinds)].format(i))
+        if i % 20 == 0:
+            lines.append('gen.add_subscriber("subscriber_{0}", message_type="std_msgs::Header", description="sub", '
+                         'default_topic="in_{0}", configurable=True, diagnosed=True)'.format(i))
+            lines.append('gen.add_publisher("publisher_{0}", message_type="std_msgs::Header", description="pub", '
+                         'default_topic="out_{0}", configurable=True)'.format(i))
+    lines.append('exit(gen.generate("rosinterface_handler", "benchmark_node", "Benchmark"))')
+    return "\n".join(lines) + "\n"
+
+
+def generate(rosif, out_dir, profile):
+    sys.argv = [rosif, ROOT_DIR, os.path.join(out_dir, "share"), os.path.join(out_dir, "include"),
+                os.path.join(out_dir, "py")] + (["--profile"] if profile else [])
+    start_time = time.time()
+    try:
+        runpy.run_path(rosif, run_name="__main__")
+    except SystemExit as e:
+        if e.code:
+            sys.exit("Generating the benchmark interface failed")
+    return time.time() - start_time
+
+
+def main(argv):
+    options = dict(arg[2:].split("=", 1) for arg in argv if arg.startswith("--") and "=" in arg)
+    parameters = int(options.get("parameters", 1000))
+    repetitions = int(options.get("repetitions", 10))
+
+    out_dir = tempfile.mkdtemp(prefix="rosinterface_benchmark")
+    try:
+        rosif = os.path.join(out_dir, "Benchmark.rosif")
+        with open(rosif, 'w') as f:
+            f.write(synthetic_rosif(parameters))
+        stdout = sys.stdout
+        times = []
+        try:
+            sys.stdout = open(os.devnull, 'w')
+            for _ in range(repetitions):
+                times.append(generate(rosif, out_dir, False))
+        finally:
+            sys.stdout.close()
+            sys.stdout = stdout
+        times.sort()
+        print("Generating {} parameters: fastest {:.1f} ms, median {:.1f} ms ({} runs)".format(
+            parameters, times[0] * 1000., times[len(times) // 2] * 1000., repetitions))
+        generate(rosif, out_dir, True)
+    finally:
+        shutil.rmtree(out_dir)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
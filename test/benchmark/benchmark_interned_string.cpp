@@ -0,0 +1,41 @@
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <rosinterface_handler/string_pool.hpp>
+
+namespace {
+// longer than the small string buffer, like most tf frame ids with a prefix
+const std::string frameIdString{"robot_namespace/sensor_mount/front_left_camera_optical_frame"};
+const rosinterface_handler::InternedString frameIdInterned{frameIdString};
+
+template <typename StringT>
+struct Header {
+    StringT frameId;
+};
+} // namespace
+
+// Stamping the frame id of a parameter into a batch of messages
+template <typename StringT>
+static void copyFrameId(benchmark::State& state, const StringT& frameId) {
+    std::vector<Header<StringT>> headers(100);
+    for (auto _ : state) {
+        for (auto& header : headers) {
+            header.frameId = frameId;
+        }
+        benchmark::DoNotOptimize(headers.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_CAPTURE(copyFrameId, string, frameIdString);
+BENCHMARK_CAPTURE(copyFrameId, interned, frameIdInterned);
+
+// Checking whether a reconfigure changed the frame id
+template <typename StringT>
+static void compareFrameId(benchmark::State& state, const StringT& frameId) {
+    const StringT unchanged{frameIdString};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frameId == unchanged);
+    }
+}
+BENCHMARK_CAPTURE(compareFrameId, string, frameIdString);
+BENCHMARK_CAPTURE(compareFrameId, interned, frameIdInterned);
@@ -0,0 +1,72 @@
+#include <sstream>
+#include <benchmark/benchmark.h>
+#include <ros/console.h>
+#include <ros/time.h>
+#include <rosinterface_handler/utilities.hpp>
+
+// Compares formatting via asString (an intermediate string) to streaming the arguments directly. The log level of
+// "benchmark" is info, so debug messages are suppressed and info messages are throttled after the first call.
+
+static void suppressedDebugAsString(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        ROS_DEBUG_STREAM_NAMED("benchmark", rosinterface_handler::asString("Iteration ", ++i, " value ", 1.5));
+    }
+}
+BENCHMARK(suppressedDebugAsString);
+
+static void suppressedDebugStreamed(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        ROS_DEBUG_STREAM_NAMED("benchmark", rosinterface_handler::streamed("Iteration ", ++i, " value ", 1.5));
+    }
+}
+BENCHMARK(suppressedDebugStreamed);
+
+static void throttledInfoAsString(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        ROS_INFO_STREAM_THROTTLE_NAMED(1000, "benchmark", rosinterface_handler::asString("Iteration ", ++i));
+    }
+}
+BENCHMARK(throttledInfoAsString);
+
+static void throttledInfoStreamed(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        ROS_INFO_STREAM_THROTTLE_NAMED(1000, "benchmark", rosinterface_handler::streamed("Iteration ", ++i));
+    }
+}
+BENCHMARK(throttledInfoStreamed);
+
+// Cost of an emitted message, measured without console output
+static void emittedAsString(benchmark::State& state) {
+    std::ostringstream oss;
+    int i = 0;
+    for (auto _ : state) {
+        oss.str("");
+        oss << rosinterface_handler::asString("Iteration ", ++i, " value ", 1.5);
+        benchmark::DoNotOptimize(oss);
+    }
+}
+BENCHMARK(emittedAsString);
+
+static void emittedStreamed(benchmark::State& state) {
+    std::ostringstream oss;
+    int i = 0;
+    for (auto _ : state) {
+        oss.str("");
+        oss << rosinterface_handler::streamed("Iteration ", ++i, " value ", 1.5);
+        benchmark::DoNotOptimize(oss);
+    }
+}
+BENCHMARK(emittedStreamed);
+
+int main(int argc, char** argv) {
+    ros::Time::init();
+    ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME ".benchmark", ros::console::levels::Info);
+    ros::console::notifyLoggerLevelsChanged();
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
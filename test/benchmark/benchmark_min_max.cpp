@@ -0,0 +1,44 @@
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <rosinterface_handler/utilities.hpp>
+
+namespace {
+std::vector<double> calibrationTable(std::size_t size) {
+    std::mt19937 gen(42); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_real_distribution<double> dist(-0.1, 1.1);
+    std::vector<double> values(size);
+    for (auto& v : values) {
+        v = dist(gen);
+    }
+    return values;
+}
+} // namespace
+
+// The former element wise implementation (without logging each violation)
+static void clampElementwise(benchmark::State& state) {
+    const auto table = calibrationTable(state.range(0));
+    for (auto _ : state) {
+        auto values = table;
+        for (auto& v : values) {
+            if (v < 0.) {
+                v = 0.;
+            }
+            if (v > 1.) {
+                v = 1.;
+            }
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+BENCHMARK(clampElementwise)->Arg(1000)->Arg(100000);
+
+static void clampBulk(benchmark::State& state) {
+    const auto table = calibrationTable(state.range(0));
+    for (auto _ : state) {
+        auto values = table;
+        benchmark::DoNotOptimize(rosinterface_handler::detail::clampMin(values.data(), values.size(), 0.));
+        benchmark::DoNotOptimize(rosinterface_handler::detail::clampMax(values.data(), values.size(), 1.));
+    }
+}
+BENCHMARK(clampBulk)->Arg(1000)->Arg(100000);
@@ -0,0 +1,52 @@
+#include <sstream>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <rosinterface_handler/utilities.hpp>
+
+namespace {
+// The former implementation of getNodeName
+std::string nodeNameStream(const std::string& privateNamespace) {
+    std::stringstream tempString(privateNamespace);
+    std::string name;
+    while (std::getline(tempString, name, '/')) {
+        ;
+    }
+    return name;
+}
+
+const std::string privateNamespace{"/some/deeply/nested/namespace/node_name"};
+const std::string publicNamespace{"/some/deeply/nested/namespace/"};
+} // namespace
+
+static void nodeNameStream(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nodeNameStream(privateNamespace));
+    }
+}
+BENCHMARK(nodeNameStream);
+
+static void nodeNameOf(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rosinterface_handler::nodeNameOf(privateNamespace));
+    }
+}
+BENCHMARK(nodeNameOf);
+
+// A reconfigure that resolves the topics of ten subscribers
+static void reconfigureGetTopic(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int i = 0; i < 10; ++i) {
+            benchmark::DoNotOptimize(rosinterface_handler::getTopic(publicNamespace, "input_topic_name"));
+        }
+    }
+}
+BENCHMARK(reconfigureGetTopic);
+
+static void reconfigureGetTopicInterned(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int i = 0; i < 10; ++i) {
+            benchmark::DoNotOptimize(&rosinterface_handler::getTopicInterned(publicNamespace, "input_topic_name"));
+        }
+    }
+}
+BENCHMARK(reconfigureGetTopicInterned);
@@ -0,0 +1,13 @@
+import unittest
+from rosinterface_handler.interface.ConstantsInterface import ConstantsInterface
+
+
+class TestConstantsInterface(unittest.TestCase):
+    def test_constant_parameters(self):
+        params = ConstantsInterface()
+        self.assertEqual(params.int_const, 3)
+        self.assertEqual(params.str_const, "Hello World")
+        self.assertEqual(params.vector_int_const, [1, 2, 3])
+        self.assertEqual(params.vector_string_const, ["Hello", "World"])
+        self.assertEqual(params.array_double_const, [0.5, 1.5])
+        self.assertEqual(params.enum_int_param_Large, 2)
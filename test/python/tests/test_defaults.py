@@ -19,6 +19,7 @@ class TestDefaults(unittest.TestCase):
         self.assertEqual(params.int_param_w_default, 1)
         self.assertAlmostEqual(params.double_param_w_default, 1.1)
         self.assertEqual(params.str_param_w_default, "Hello World")
+        self.assertEqual(params.frame_id_param_w_default, "base_link")
         self.assertEqual(params.bool_param_w_default, True)
         self.assertEqual(params.long_param_w_default_int, 1)
         self.assertEqual(params.long_param_w_default_int_str, -1)
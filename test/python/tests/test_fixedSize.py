@@ -0,0 +1,14 @@
+import unittest
+from rosinterface_handler.interface.FixedSizeInterface import FixedSizeInterface
+
+
+class TestFixedSizeInterface(unittest.TestCase):
+    def test_fixed_size_parameters(self):
+        params = FixedSizeInterface()
+        self.assertEqual(params.array_int_param, [1, 2, 3])
+        self.assertEqual(params.array_string_param, ["Hello", "World"])
+        self.assertEqual(params.array_double_param_w_minmax, [0., 1.2, 2.])
+        self.assertEqual(params.vector3d_param, [1., 2., 3.])
+        self.assertEqual(params.matrix_param, [1., 2., 3., 4., 5., 6.])
+        self.assertEqual(params.matrix3f_param_w_minmax, [1., 0., 0., 0., 0., 0., 0., 0., 2.])
+        self.assertEqual(params.matrix_param_wo_default, [1.1, 1.2, 2.1, 2.2])
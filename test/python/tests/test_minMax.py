@@ -12,3 +12,4 @@ class TestMinMaxInterface(unittest.TestCase):
         self.assertEqual(params.vector_double_param_w_minmax, [0, 1.2, 2.])
 
         self.assertEqual(params.map_param_w_minmax, {"value1": 0., "value2": 1.2, "value3": 2.})
+        self.assertEqual(params.flat_map_param_w_minmax, {"value1": 0., "value2": 1.2, "value3": 2.})
@@ -0,0 +1,11 @@
+import unittest
+from rosinterface_handler.interface.SpecializedInterface import SpecializedInterface
+
+
+class TestSpecializedInterface(unittest.TestCase):
+    def test_specialized_parameters(self):
+        params = SpecializedInterface()
+        self.assertEqual(params.int_param_specialized, 5)
+        self.assertEqual(params.str_param_specialized, "Hello World")
+        self.assertEqual(params.vector_double_param_specialized, [1.5, 2.5, 3.5])
+        self.assertEqual(params.int_param_not_specialized, 1)
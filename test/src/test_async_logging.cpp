@@ -0,0 +1,73 @@
+#include <map>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <rosinterface_handler/logger.hpp>
+
+using rosinterface_handler::MpscRingBuffer;
+
+TEST(MpscRingBuffer, pushPopInOrder) {
+    MpscRingBuffer<int, 4> buffer;
+    int value = 0;
+    EXPECT_FALSE(buffer.pop(value));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(buffer.push(int(i)));
+    }
+    // full
+    EXPECT_FALSE(buffer.push(4));
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_TRUE(buffer.push(5));
+    ASSERT_TRUE(buffer.pop(value));
+    EXPECT_EQ(5, value);
+}
+
+TEST(MpscRingBuffer, multipleProducers) {
+    constexpr int NumThreads = 4;
+    constexpr int NumValues = 10000;
+    MpscRingBuffer<int, 64> buffer;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < NumThreads; ++t) {
+        producers.emplace_back([&buffer]() {
+            for (int i = 0; i < NumValues; ++i) {
+                while (!buffer.push(1)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    int sum = 0;
+    int value = 0;
+    while (sum < NumThreads * NumValues) {
+        if (buffer.pop(value)) {
+            sum += value;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(NumThreads * NumValues, sum);
+    EXPECT_FALSE(buffer.pop(value));
+}
+
+TEST(AsyncLogger, logsWithoutDropping) {
+    rosinterface_handler::Logger logger(std::string(ROSCONSOLE_NAME_PREFIX) + ".async_test", true);
+    ASSERT_TRUE(logger.isAsync());
+    for (int i = 0; i < 10; ++i) {
+        ROSINTERFACE_WARN(logger, "Asynchronous message ", i);
+    }
+    EXPECT_EQ(0, logger.droppedMessages());
+}
+
+TEST(Logger, logsContainers) {
+    rosinterface_handler::Logger logger(std::string(ROSCONSOLE_NAME_PREFIX) + ".container_test");
+    const std::vector<int> vector{1, 2};
+    const std::map<std::string, double> map{{"a", 1.5}};
+    ROSINTERFACE_WARN(logger, "vector ", vector, " map ", map);
+    logger.print(ros::console::levels::Warn, __FILE__, __LINE__, __func__, "vector ", vector, " map ", map);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <rosinterface_handler/ConstantsInterface.h>
+
+using IfType = rosinterface_handler::ConstantsInterface;
+
+namespace {
+template <int Size>
+constexpr int kernel() {
+    return Size * 2;
+}
+
+constexpr bool dispatch(std::true_type /*enabled*/) {
+    return true;
+}
+constexpr bool dispatch(std::false_type /*enabled*/) {
+    return false;
+}
+} // namespace
+
+// constants can be used in constant expressions
+static_assert(IfType::int_const == 3, "");
+static_assert(kernel<IfType::int_const>() == 6, "");
+static_assert(IfType::str_const == "Hello World", "");
+static_assert(IfType::vector_int_const.size() == 3 && IfType::vector_int_const[2] == 3, "");
+static_assert(IfType::vector_string_const[1] == "World", "");
+static_assert(IfType::array_double_const[1] == 1.5, "");
+static_assert(IfType::long_const == -4, "");
+
+// and as types
+static_assert(std::is_same<IfType::ConstantTraits::int_const, std::integral_constant<int, 3>>::value, "");
+static_assert(dispatch(IfType::ConstantTraits::bool_const{}), "");
+static_assert(IfType::ConstantTraits::enum_int_param_Large::value == 2, "");
+
+TEST(RosinterfaceHandler, Constants) {
+    IfType testInterface(ros::NodeHandle("~"));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(testInterface.fromParamServer());
+
+    ASSERT_DOUBLE_EQ(1.5, testInterface.double_const);
+    ASSERT_TRUE(testInterface.bool_const);
+    ASSERT_EQ("Hello World", testInterface.str_const);
+    ASSERT_EQ(1, testInterface.enum_int_param);
+    ASSERT_EQ(testInterface.publisher_const.getTopic(), "/test/rosinterface_handler_test/out_topic");
+}
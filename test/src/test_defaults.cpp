@@ -1,4 +1,6 @@
+#include <sstream>
 #include <gtest/gtest.h>
+#include <ros/ros.h>
 #include <rosinterface_handler/DefaultsInterface.h>
 #include <rosinterface_handler/simple_node_status.hpp>
 
@@ -14,6 +16,7 @@ TEST(RosinterfaceHandler, DefaultParams) { // NOLINT(readability-function-size)
     ASSERT_EQ(1, testInterface.int_param_w_default);
     ASSERT_DOUBLE_EQ(1.1, testInterface.double_param_w_default);
     ASSERT_EQ("Hello World", testInterface.str_param_w_default);
+    ASSERT_EQ("base_link", testInterface.frame_id_param_w_default);
     ASSERT_EQ(true, testInterface.bool_param_w_default);
     ASSERT_EQ(1L, testInterface.long_param_w_default_int);
     ASSERT_EQ(-1L, testInterface.long_param_w_default_int_str);
@@ -29,9 +32,162 @@ TEST(RosinterfaceHandler, DefaultParams) { // NOLINT(readability-function-size)
 
     ASSERT_EQ(1, testInterface.enum_int_param_w_default);
     ASSERT_EQ("One", testInterface.enum_str_param_w_default);
+    ASSERT_EQ(2, testInterface.buffer);
+    ASSERT_EQ("Out", testInterface.out);
     testInterface.showNodeInfo();
 }
 
+namespace {
+// only needs the parameter values, not the interface
+int intParam(const rosinterface_handler::DefaultsParameters& params) {
+    return params.int_param_w_default;
+}
+} // namespace
+
+TEST(RosinterfaceHandler, ParametersOnly) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    ASSERT_EQ(1, intParam(testInterface));
+}
+
+TEST(RosinterfaceHandler, Printing) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    std::ostringstream oss;
+    oss << testInterface;
+    const auto str = testInterface.toString();
+    EXPECT_EQ(oss.str(), str);
+    EXPECT_NE(std::string::npos, str.find("\t" + testInterface.nodeNameWithNamespace() + "/int_param_w_default:1\n"));
+    EXPECT_NE(std::string::npos, str.find("\t" + testInterface.nodeNameWithNamespace() + "/out:Out\n"));
+
+    const auto json = testInterface.toJson();
+    EXPECT_EQ(0u, json.find(R"({"node":")" + testInterface.nodeNameWithNamespace() + R"(","parameters":{)"));
+    EXPECT_NE(std::string::npos, json.find(R"("int_param_w_default":1,)"));
+    EXPECT_NE(std::string::npos, json.find(R"("vector_bool_param_w_default":[false,true])"));
+    EXPECT_NE(std::string::npos, json.find(R"("map_param_w_default":{"Hello":"World"})"));
+    EXPECT_NE(std::string::npos, json.find(R"("out":"Out")"));
+    EXPECT_EQ("}}", json.substr(json.size() - 2));
+}
+
+TEST(RosinterfaceHandler, Serialization) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    testInterface.int_param_w_default = 5;
+    testInterface.str_param_w_default = "Serialized";
+    testInterface.vector_bool_param_w_default = {true, true, false};
+    testInterface.map_param_w_default["Bye"] = "World";
+    testInterface.buffer = 7;
+    rosinterface_handler::SerializationBuffer buffer;
+    testInterface.serialize(buffer);
+
+    IfType otherInterface(ros::NodeHandle("~"));
+    ASSERT_TRUE(otherInterface.deserialize(buffer));
+    ASSERT_EQ(5, otherInterface.int_param_w_default);
+    ASSERT_EQ("Serialized", otherInterface.str_param_w_default);
+    ASSERT_EQ("base_link", otherInterface.frame_id_param_w_default);
+    ASSERT_EQ(std::vector<bool>({true, true, false}), otherInterface.vector_bool_param_w_default);
+    ASSERT_EQ(testInterface.map_param_w_default, otherInterface.map_param_w_default);
+    ASSERT_EQ(9223372036854775807L, otherInterface.long_param_w_default_long_string);
+    ASSERT_EQ(7, otherInterface.buffer);
+    rosinterface_handler::SerializationBuffer otherBuffer;
+    otherInterface.serialize(otherBuffer);
+    ASSERT_EQ(buffer, otherBuffer);
+}
+
+TEST(RosinterfaceHandler, SerializationInvalidData) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    rosinterface_handler::SerializationBuffer buffer;
+    testInterface.serialize(buffer);
+    testInterface.int_param_w_default = 5;
+
+    // incomplete data, data with a different layout and trailing data change nothing
+    ASSERT_FALSE(testInterface.deserialize(buffer.data(), buffer.size() - 1));
+    auto otherLayout = buffer;
+    otherLayout[0] ^= 1U;
+    ASSERT_FALSE(testInterface.deserialize(otherLayout));
+    auto trailing = buffer;
+    trailing.push_back(0);
+    ASSERT_FALSE(testInterface.deserialize(trailing));
+    ASSERT_EQ(5, testInterface.int_param_w_default);
+
+    ASSERT_TRUE(testInterface.deserialize(buffer));
+    ASSERT_EQ(1, testInterface.int_param_w_default);
+}
+
+TEST(RosinterfaceHandler, SerializationMovesTopics) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    testInterface.subscriber_w_default_topic = "/in_topic_deserialized";
+    testInterface.publisher_w_default_topic = "/out_topic_deserialized";
+    rosinterface_handler::SerializationBuffer buffer;
+    testInterface.serialize(buffer);
+
+    IfType otherInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(otherInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    ASSERT_TRUE(otherInterface.deserialize(buffer));
+    EXPECT_EQ("/in_topic_deserialized", otherInterface.subscriber_w_default->getTopic());
+    EXPECT_EQ("/out_topic_deserialized", otherInterface.publisher_w_default.getTopic());
+}
+
+TEST(RosinterfaceHandler, ConfigSnapshot) {
+    ros::NodeHandle nh("~");
+    IfType testInterface(nh);
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+
+    std::vector<std_msgs::UInt8MultiArray> snapshots;
+    ros::Subscriber subscriber = nh.subscribe<std_msgs::UInt8MultiArray>(
+        "config_snapshot", 5, [&](const std_msgs::UInt8MultiArray::ConstPtr& msg) { snapshots.push_back(*msg); });
+    for (int i = 0; i < 100 && snapshots.empty(); ++i) {
+        ros::spinOnce();
+        ros::WallDuration(0.01).sleep();
+    }
+    ASSERT_EQ(1, snapshots.size());
+    EXPECT_TRUE(rosinterface_handler::ConfigSnapshot::isSnapshot(snapshots[0]));
+
+    // publishes only if something changed
+    testInterface.int_param_w_default = 3;
+    testInterface.publishConfigSnapshot();
+    testInterface.publishConfigSnapshot();
+    for (int i = 0; i < 100 && snapshots.size() < 2; ++i) {
+        ros::spinOnce();
+        ros::WallDuration(0.01).sleep();
+    }
+    ros::spinOnce();
+    ASSERT_EQ(2, snapshots.size());
+
+    // every message contains all values, so the latest one is enough. Applying it publishes it again.
+    IfType otherInterface(ros::NodeHandle("~"));
+    ASSERT_TRUE(otherInterface.applyConfigSnapshot(snapshots[1]));
+    ASSERT_EQ(3, otherInterface.int_param_w_default);
+    ASSERT_EQ("Hello World", otherInterface.str_param_w_default);
+    ASSERT_TRUE(otherInterface.applyConfigSnapshot(snapshots[0]));
+    ASSERT_EQ(1, otherInterface.int_param_w_default);
+    for (int i = 0; i < 100 && snapshots.size() < 4; ++i) {
+        ros::spinOnce();
+        ros::WallDuration(0.01).sleep();
+    }
+    ASSERT_EQ(4, snapshots.size());
+    EXPECT_EQ(snapshots[1].data, snapshots[2].data);
+    EXPECT_EQ(snapshots[0].data, snapshots[3].data);
+
+    // a late subscriber gets the current configuration
+    std::vector<std_msgs::UInt8MultiArray> lateSnapshots;
+    ros::Subscriber lateSubscriber = nh.subscribe<std_msgs::UInt8MultiArray>(
+        "config_snapshot", 5, [&](const std_msgs::UInt8MultiArray::ConstPtr& msg) { lateSnapshots.push_back(*msg); });
+    for (int i = 0; i < 100 && lateSnapshots.empty(); ++i) {
+        ros::spinOnce();
+        ros::WallDuration(0.01).sleep();
+    }
+    ASSERT_EQ(1, lateSnapshots.size());
+    ASSERT_TRUE(testInterface.applyConfigSnapshot(lateSnapshots[0]));
+    ASSERT_EQ(1, testInterface.int_param_w_default);
+
+    auto invalid = snapshots[1];
+    invalid.layout.dim.clear();
+    ASSERT_FALSE(otherInterface.applyConfigSnapshot(invalid));
+}
+
 TEST(RosinterfaceHandler, NodeStatus) {
     IfType testInterface(ros::NodeHandle("~"));
     testInterface.nodeStatus.set(rosinterface_handler::NodeStatus::ERROR, "Test error");
@@ -156,6 +312,7 @@ TEST(RosinterfaceHandler, SetParamOnServer) { // NOLINT(readability-function-siz
     testInterface.int_param_w_default = 2;
     testInterface.double_param_w_default = 2.2;
     testInterface.str_param_w_default = "World Hello";
+    testInterface.frame_id_param_w_default = "odom";
     testInterface.bool_param_w_default = false;
     testInterface.long_param_w_default_int = 1L;
     testInterface.long_param_w_default_int_str = -1L;
@@ -214,6 +371,11 @@ TEST(RosinterfaceHandler, SetParamOnServer) { // NOLINT(readability-function-siz
         ASSERT_TRUE(nh.getParam("str_param_w_default", stringInterface));
         EXPECT_EQ(stringInterface, testInterface.str_param_w_default);
     }
+    {
+        std::string stringInterface;
+        ASSERT_TRUE(nh.getParam("frame_id_param_w_default", stringInterface));
+        EXPECT_EQ(stringInterface, testInterface.frame_id_param_w_default);
+    }
     {
         std::vector<int> vectorIntInterface;
         ASSERT_TRUE(nh.getParam("vector_int_param_w_default", vectorIntInterface));
@@ -286,3 +448,70 @@ TEST(RosinterfaceHandler, FromDynamicReconfigure) { // NOLINT(readability-functi
     EXPECT_EQ(testInterface.publisher_public_w_default.getTopic(), "/out_topic");
     EXPECT_EQ(testInterface.publisher_global_w_default.getTopic(), "/out_topic");
 }
+
+TEST(RosinterfaceHandler, FromDynamicReconfigureDoesNotPoolTopics) {
+    ros::NodeHandle nh("~");
+    IfType testInterface(nh);
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    const auto numStrings = rosinterface_handler::StringPool::instance().size();
+
+    ConfigType config;
+    config.subscriber_diag_w_default_topic = "in_point_topic";
+    config.subscriber_public_w_default_topic = "in_topic";
+    config.subscriber_global_w_default_topic = "in_topic";
+    config.subscriber_smart_topic = "in_topic2";
+    config.publisher_diag_w_default_topic = "out_point_topic";
+    config.publisher_public_w_default_topic = "out_topic";
+    config.publisher_global_w_default_topic = "out_topic";
+    for (int i = 0; i < 3; ++i) {
+        config.subscriber_w_default_topic = "in_topic_" + std::to_string(i);
+        config.publisher_w_default_topic = "out_topic_" + std::to_string(i);
+        testInterface.fromConfig(config);
+        EXPECT_EQ(testInterface.subscriber_w_default->getTopic(), nh.getNamespace() + "/in_topic_" + std::to_string(i));
+    }
+    EXPECT_EQ(numStrings, rosinterface_handler::StringPool::instance().size());
+}
+
+namespace {
+struct CountingArg {
+    static int numStreamed;
+};
+int CountingArg::numStreamed = 0;
+std::ostream& operator<<(std::ostream& os, const CountingArg& /*arg*/) {
+    ++CountingArg::numStreamed;
+    return os << "counted";
+}
+} // namespace
+
+TEST(RosinterfaceHandler, LazyLogging) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    ASSERT_EQ("info", testInterface.verbosity_param_w_default);
+
+    // debug output is disabled: nothing is formatted
+    CountingArg::numStreamed = 0;
+    testInterface.logDebug("Debug ", CountingArg{});
+    EXPECT_EQ(0, CountingArg::numStreamed);
+
+    // the second message is throttled: only the first one is formatted
+    testInterface.logInfo("Info ", CountingArg{});
+    testInterface.logInfo("Info ", CountingArg{});
+    EXPECT_EQ(1, CountingArg::numStreamed);
+}
+
+TEST(RosinterfaceHandler, ThrottlePerCallSite) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+
+    // each call site has its own throttle, so both are printed once
+    CountingArg::numStreamed = 0;
+    for (int i = 0; i < 3; ++i) {
+        ROSINTERFACE_INFO_THROTTLE(testInterface.logger(), 5, "First ", CountingArg{});
+        ROSINTERFACE_INFO_THROTTLE(testInterface.logger(), 5, "Second ", CountingArg{});
+    }
+    EXPECT_EQ(2, CountingArg::numStreamed);
+
+    CountingArg::numStreamed = 0;
+    ROSINTERFACE_DEBUG(testInterface.logger(), "Debug ", CountingArg{});
+    EXPECT_EQ(0, CountingArg::numStreamed);
+}
@@ -117,6 +117,63 @@ TEST_F(TestDiagnosedPubSub, assign) {
     ASSERT_LE(1, updater.statusVec.size());
 }
 
+TEST_F(TestDiagnosedPubSub, changeThresholdsInPlace) {
+    auto onTimer = [this](const ros::TimerEvent& e) {
+        this->messageCounter++;
+        auto msg = boost::make_shared<MsgT>();
+        msg->header.stamp = e.current_real - ros::Duration(0.5);
+        this->pub.publish(msg);
+    };
+    auto timer = nh.createTimer(ros::Duration(0.05), onTimer);
+    while (messageCounter < 10) {
+        ros::spinOnce();
+    }
+    auto publisherStatus = [this]() {
+        updater.forceUpdate();
+        auto found = std::find_if(updater.statusVec.begin(), updater.statusVec.end(),
+                                  [&](const auto& status) { return status.name == pub.getTopic() + " topic status"; });
+        EXPECT_NE(found, updater.statusVec.end());
+        return found == updater.statusVec.end() ? diagnostic_msgs::DiagnosticStatus() : *found;
+    };
+    ASSERT_EQ(diagnostic_msgs::DiagnosticStatus::OK, publisherStatus().level);
+    const auto numTasks = updater.statusVec.size();
+
+    // thresholds are applied without re-registering the publisher
+    pub.minFrequency(1.).maxTimeDelay(0.1);
+    messageCounter = 0;
+    while (messageCounter < 10) {
+        ros::spinOnce();
+    }
+    const auto status = publisherStatus();
+    EXPECT_EQ(numTasks, updater.statusVec.size());
+    EXPECT_EQ(diagnostic_msgs::DiagnosticStatus::ERROR, status.level);
+    EXPECT_NE(std::string::npos, status.message.find("Timestamps too far in past seen."));
+}
+
+TEST_F(TestDiagnosedPubSub, copiesShareThresholds) {
+    {
+        DiagPub copy = pub;
+        copy.maxTimeDelay(0.1);
+    }
+    // advertising again must not bring back the old thresholds
+    pub = nh.advertise<MsgT>("test_topic", 5);
+    auto onTimer = [this](const ros::TimerEvent& e) {
+        this->messageCounter++;
+        auto msg = boost::make_shared<MsgT>();
+        msg->header.stamp = e.current_real - ros::Duration(0.5);
+        this->pub.publish(msg);
+    };
+    auto timer = nh.createTimer(ros::Duration(0.05), onTimer);
+    while (messageCounter < 10) {
+        ros::spinOnce();
+    }
+    updater.forceUpdate();
+    auto found = std::find_if(updater.statusVec.begin(), updater.statusVec.end(),
+                              [&](const auto& status) { return status.name == pub.getTopic() + " topic status"; });
+    ASSERT_NE(found, updater.statusVec.end());
+    EXPECT_EQ(diagnostic_msgs::DiagnosticStatus::ERROR, found->level);
+}
+
 TEST(TestDiagnosedAndSmartCombined, constructAndSubscribe) {
     ros::NodeHandle nh;
     ros::Publisher thisPublisher = nh.advertise<MsgT>("sometopic", 5);
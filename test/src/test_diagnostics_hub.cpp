@@ -0,0 +1,55 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <rosinterface_handler/diagnostics_hub.hpp>
+#include <rosinterface_handler/simple_node_status.hpp>
+
+using rosinterface_handler::HubUpdater;
+using rosinterface_handler::NodeStatus;
+using rosinterface_handler::SimpleNodeStatus;
+
+TEST(DiagnosticsHub, publishesAllUpdatersInOneMessage) {
+    ros::NodeHandle nh;
+    std::atomic<bool> received{false};
+    auto onDiagnostics = [&](const diagnostic_msgs::DiagnosticArray::ConstPtr& msg) {
+        bool foundFirst = false;
+        bool foundSecond = false;
+        for (const auto& status : msg->status) {
+            foundFirst |= status.name.find("first") != std::string::npos;
+            foundSecond |= status.name.find("second") != std::string::npos;
+        }
+        if (foundFirst && foundSecond) {
+            received = true;
+        }
+    };
+    auto sub = nh.subscribe<diagnostic_msgs::DiagnosticArray>("/diagnostics", 5, onDiagnostics);
+
+    HubUpdater updater1;
+    HubUpdater updater2;
+    SimpleNodeStatus status1("first", updater1);
+    SimpleNodeStatus status2("second", updater2);
+    status1.set(NodeStatus::OK, "ok");
+    status2.set(NodeStatus::WARN, "warn");
+
+    auto start = ros::WallTime::now();
+    while (!received && ros::WallTime::now() - start < ros::WallDuration(5.)) {
+        updater1.force_update();
+        ros::WallDuration(0.1).sleep();
+    }
+    EXPECT_TRUE(received);
+}
+
+TEST(DiagnosticsHub, collectsTasksOfUpdater) {
+    std::vector<diagnostic_msgs::DiagnosticStatus> statusVec;
+    HubUpdater updater;
+    {
+        SimpleNodeStatus status("temporary", updater);
+        status.set(NodeStatus::ERROR, "error");
+        updater.collect(statusVec);
+        ASSERT_EQ(1, statusVec.size());
+        EXPECT_EQ(diagnostic_msgs::DiagnosticStatus::ERROR, statusVec.front().level);
+        EXPECT_NE(std::string::npos, statusVec.front().name.find("temporary"));
+    }
+    statusVec.clear();
+    updater.collect(statusVec);
+    EXPECT_TRUE(statusVec.empty());
+}
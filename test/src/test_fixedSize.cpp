@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <rosinterface_handler/FixedSizeInterface.h>
+
+using IfType = rosinterface_handler::FixedSizeInterface;
+using ConfigType = rosinterface_handler::FixedSizeConfig;
+
+TEST(RosinterfaceHandler, FixedSize) { // NOLINT(readability-function-size)
+    IfType testInterface(ros::NodeHandle("~"));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(testInterface.fromParamServer());
+
+    ASSERT_EQ((std::array<int, 3>{1, 2, 3}), testInterface.array_int_param);
+    ASSERT_EQ((std::array<std::string, 2>{"Hello", "World"}), testInterface.array_string_param);
+    ASSERT_EQ((std::array<double, 3>{0., 1.2, 2.}), testInterface.array_double_param_w_minmax);
+
+    ASSERT_EQ(Eigen::Vector3d(1., 2., 3.), testInterface.vector3d_param);
+    Eigen::Matrix<double, 2, 3> matrix;
+    matrix << 1., 2., 3., 4., 5., 6.;
+    ASSERT_EQ(matrix, testInterface.matrix_param);
+    ASSERT_EQ(Eigen::Vector3f(1.f, 0.f, 2.f), testInterface.matrix3f_param_w_minmax.diagonal());
+    ASSERT_EQ(0.f, testInterface.matrix3f_param_w_minmax(1, 0));
+
+    Eigen::Matrix2d matrixAtLaunch;
+    matrixAtLaunch << 1.1, 1.2, 2.1, 2.2;
+    ASSERT_EQ(matrixAtLaunch, testInterface.matrix_param_wo_default);
+}
+
+TEST(RosinterfaceHandler, FixedSizeRoundTrip) {
+    IfType testInterface(ros::NodeHandle("~"));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(testInterface.fromParamServer());
+    testInterface.matrix_param(1, 0) = 42.;
+    testInterface.array_string_param[0] = "Bye";
+    testInterface.toParamServer();
+
+    IfType otherInterface(ros::NodeHandle("~"));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(otherInterface.fromParamServer());
+    ASSERT_EQ(testInterface.matrix_param, otherInterface.matrix_param);
+    ASSERT_EQ(testInterface.array_string_param, otherInterface.array_string_param);
+
+    // restore the defaults for other tests
+    testInterface.matrix_param(1, 0) = 4.;
+    testInterface.array_string_param[0] = "Hello";
+    testInterface.toParamServer();
+}
+
+TEST(RosinterfaceHandler, FixedSizeSerialization) {
+    IfType testInterface(ros::NodeHandle("~"));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(testInterface.fromParamServer());
+    testInterface.matrix_param(1, 0) = 42.;
+    testInterface.array_string_param[0] = "Bye";
+    rosinterface_handler::SerializationBuffer buffer;
+    testInterface.serialize(buffer);
+
+    IfType otherInterface(ros::NodeHandle("~"));
+    ASSERT_TRUE(otherInterface.deserialize(buffer));
+    ASSERT_EQ(testInterface.matrix_param, otherInterface.matrix_param);
+    ASSERT_EQ(testInterface.array_string_param, otherInterface.array_string_param);
+    ASSERT_EQ(testInterface.array_int_param, otherInterface.array_int_param);
+}
+
+TEST(RosinterfaceHandler, FixedSizeWrongSize) {
+    std::array<double, 3> array{0., 0., 0.};
+    ASSERT_FALSE(rosinterface_handler::getParam(ros::NodeHandle("~").getNamespace() + "/array_param_wrong_size", array));
+    ASSERT_EQ((std::array<double, 3>{0., 0., 0.}), array);
+}
@@ -17,4 +17,8 @@ TEST(RosinterfaceHandler, MinMax) {
 
     std::map<std::string, double> tmp{{"value1", 0.}, {"value2", 1.2}, {"value3", 2.}};
     ASSERT_EQ(tmp, testInterface.map_param_w_minmax);
+
+    rosinterface_handler::FlatMap<std::string, double> flatTmp{{"value1", 0.}, {"value2", 1.2}, {"value3", 2.}};
+    ASSERT_EQ(flatTmp, testInterface.flat_map_param_w_minmax);
+    ASSERT_DOUBLE_EQ(1.2, testInterface.flat_map_param_w_minmax.at(std::string_view("value2")));
 }
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <rosinterface_handler/NodeletInterface.h>
+
+using IfType = rosinterface_handler::NodeletInterface;
+using ConfigType = rosinterface_handler::NodeletConfig;
+
+TEST(RosinterfaceHandler, DiagnosticsOfAllInterfacesInOneArray) {
+    ros::NodeHandle nh;
+    std::atomic<bool> received{false};
+    auto onDiagnostics = [&](const diagnostic_msgs::DiagnosticArray::ConstPtr& msg) {
+        bool foundFirst = false;
+        bool foundSecond = false;
+        for (const auto& status : msg->status) {
+            foundFirst |= status.name.find("first: status") != std::string::npos;
+            foundSecond |= status.name.find("second: status") != std::string::npos;
+        }
+        if (foundFirst && foundSecond) {
+            received = true;
+        }
+    };
+    auto sub = nh.subscribe<diagnostic_msgs::DiagnosticArray>("/diagnostics", 5, onDiagnostics);
+
+    IfType first(ros::NodeHandle("~first"));
+    IfType second(ros::NodeHandle("~second"));
+    ASSERT_NO_THROW(first.fromParamServer());  // NOLINT(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(second.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    first.nodeStatus.set(rosinterface_handler::NodeStatus::OK, "Running");
+    second.nodeStatus.set(rosinterface_handler::NodeStatus::WARN, "Waiting");
+
+    auto start = ros::WallTime::now();
+    while (!received && ros::WallTime::now() - start < ros::WallDuration(5.)) {
+        first.updater.force_update();
+        ros::WallDuration(0.1).sleep();
+    }
+    EXPECT_TRUE(received);
+}
+
+TEST(RosinterfaceHandler, DiagnosedTopicsRegisterAtHub) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    std::vector<diagnostic_msgs::DiagnosticStatus> statusVec;
+    testInterface.updater.collect(statusVec);
+    auto hasStatus = [&](const std::string& name) {
+        return std::any_of(statusVec.begin(), statusVec.end(),
+                           [&](const auto& status) { return status.name.find(name) != std::string::npos; });
+    };
+    EXPECT_TRUE(hasStatus(": status"));
+    EXPECT_TRUE(hasStatus("out_point_topic topic status"));
+    EXPECT_TRUE(hasStatus("in_point_topic subscriber topic status"));
+    EXPECT_TRUE(hasStatus(": logging"));
+}
+
+TEST(RosinterfaceHandler, AsyncLoggingReportsStatus) {
+    IfType testInterface(ros::NodeHandle("~"));
+    ASSERT_NO_THROW(testInterface.fromParamServer()); // NOLINT(cppcoreguidelines-avoid-goto)
+    testInterface.logInfo("Value: ", testInterface.int_param_w_default);
+    std::vector<diagnostic_msgs::DiagnosticStatus> statusVec;
+    testInterface.updater.collect(statusVec);
+    auto logging = std::find_if(statusVec.begin(), statusVec.end(),
+                                [](const auto& status) { return status.name.find(": logging") != std::string::npos; });
+    ASSERT_NE(logging, statusVec.end()); // NOLINT(cppcoreguidelines-avoid-goto)
+    EXPECT_EQ(diagnostic_msgs::DiagnosticStatus::OK, logging->level);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <rosinterface_handler/diagnostics_hub.hpp>
+#include <rosinterface_handler/simple_node_status.hpp>
+
+using rosinterface_handler::HubUpdater;
+using rosinterface_handler::NodeStatus;
+using rosinterface_handler::SimpleNodeStatus;
+
+// The HubUpdater is used to collect the reported status without publishing it
+TEST(SimpleNodeStatus, registeredStatus) {
+    std::vector<diagnostic_msgs::DiagnosticStatus> statusVec;
+    HubUpdater updater;
+    SimpleNodeStatus status("registered", updater);
+    auto running = status.registerStatus(NodeStatus::OK, "Running");
+    auto failed = status.registerStatus(NodeStatus::ERROR, "Failed");
+
+    status.set(running);
+    status.set(running);
+    updater.collect(statusVec);
+    ASSERT_EQ(1, statusVec.size());
+    EXPECT_EQ(diagnostic_msgs::DiagnosticStatus::OK, statusVec.front().level);
+    EXPECT_EQ("Running", statusVec.front().message);
+
+    status.set(failed);
+    statusVec.clear();
+    updater.collect(statusVec);
+    EXPECT_EQ(diagnostic_msgs::DiagnosticStatus::ERROR, statusVec.front().level);
+
+    // a formatted status invalidates the registered one
+    status.set(NodeStatus::WARN, "custom ", 1);
+    status.set(failed);
+    statusVec.clear();
+    updater.collect(statusVec);
+    EXPECT_EQ("Failed", statusVec.front().message);
+}
+
+TEST(SimpleNodeStatus, metrics) {
+    std::vector<diagnostic_msgs::DiagnosticStatus> statusVec;
+    HubUpdater updater;
+    SimpleNodeStatus status("metrics", updater);
+    auto frequency = status.registerMetric<double>("frequency");
+    auto count = status.registerMetric<int>("count");
+    auto active = status.registerMetric<bool>("active");
+    status.metric(frequency, 2.5);
+    status.metric(count, -3);
+    status.metric(active, true);
+    status.clearMetric(active);
+
+    updater.collect(statusVec);
+    ASSERT_EQ(1, statusVec.size());
+    const auto& values = statusVec.front().values;
+    ASSERT_EQ(2, values.size());
+    EXPECT_EQ("frequency", values[0].key);
+    EXPECT_EQ("2.5", values[0].value);
+    EXPECT_EQ("count", values[1].key);
+    EXPECT_EQ("-3", values[1].value);
+}
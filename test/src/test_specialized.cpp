@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <rosinterface_handler/SpecializedInterface.h>
+
+using IfType = rosinterface_handler::SpecializedInterface;
+
+// the values of test/specialization/Specialized.yaml are folded into constants
+static_assert(IfType::int_param_specialized == 5, "");
+static_assert(IfType::str_param_specialized == "Hello World", "");
+static_assert(IfType::vector_double_param_specialized.size() == 3, "");
+static_assert(IfType::vector_double_param_specialized[1] == 2.5, "");
+
+TEST(RosinterfaceHandler, Specialized) {
+    IfType testInterface(ros::NodeHandle("~"));
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    ASSERT_NO_THROW(testInterface.fromParamServer());
+
+    ASSERT_EQ(5, testInterface.int_param_specialized);
+    ASSERT_EQ("Hello World", testInterface.str_param_specialized);
+    ASSERT_EQ(1, testInterface.int_param_not_specialized);
+}
+
+TEST(RosinterfaceHandler, SpecializedMismatch) {
+    const std::string key = "~int_param_specialized_mismatch";
+    EXPECT_TRUE(rosinterface_handler::testConstParam(key, IfType::int_param_specialized));
+    ros::param::set(key, IfType::int_param_specialized);
+    EXPECT_TRUE(rosinterface_handler::testConstParam(key, IfType::int_param_specialized));
+    ros::param::set(key, 4);
+    EXPECT_FALSE(rosinterface_handler::testConstParam(key, IfType::int_param_specialized));
+    EXPECT_FALSE(rosinterface_handler::testConstParam(key, IfType::str_param_specialized));
+    ros::param::del(key);
+}
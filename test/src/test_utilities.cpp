@@ -0,0 +1,246 @@
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <type_traits>
+#include <gtest/gtest.h>
+#include <rosinterface_handler/json.hpp>
+#include <rosinterface_handler/serialization.hpp>
+#include <rosinterface_handler/utilities.hpp>
+
+namespace {
+struct UserType {};
+std::ostream& operator<<(std::ostream& os, const UserType& /*t*/) {
+    return os << "UserType";
+}
+
+template <typename... Args>
+std::string viaStream(const Args&... args) {
+    using ::operator<<;
+    std::ostringstream oss;
+    (oss << ... << args);
+    return oss.str();
+}
+} // namespace
+
+TEST(Utilities, asStringMatchesStream) {
+    using rosinterface_handler::asString;
+    EXPECT_EQ(viaStream(1, " ", -5L, " ", 7u), asString(1, " ", -5L, " ", 7u));
+    EXPECT_EQ(viaStream(std::numeric_limits<int64_t>::min()), asString(std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ(viaStream(std::numeric_limits<uint64_t>::max()), asString(std::numeric_limits<uint64_t>::max()));
+    EXPECT_EQ(viaStream(1.1, 2.5f, 1e20, 1e-7, 1234567.0, 1. / 3.), asString(1.1, 2.5f, 1e20, 1e-7, 1234567.0, 1. / 3.));
+    EXPECT_EQ(viaStream(INFINITY, -INFINITY), asString(INFINITY, -INFINITY));
+    EXPECT_EQ(viaStream(true, 'c', false), asString(true, 'c', false));
+    EXPECT_EQ("UserType 1", asString(UserType{}, " ", 1));
+}
+
+TEST(Utilities, asStringManipulators) {
+    using rosinterface_handler::asString;
+    EXPECT_EQ(viaStream(1.23456, " ", std::setprecision(3), 1.23456, " ", std::fixed, 2.5),
+              asString(1.23456, " ", std::setprecision(3), 1.23456, " ", std::fixed, 2.5));
+    EXPECT_EQ(viaStream(std::hex, 255, " ", std::boolalpha, true), asString(std::hex, 255, " ", std::boolalpha, true));
+    EXPECT_EQ(viaStream("[", std::setw(5), std::setfill('0'), 42, "]"),
+              asString("[", std::setw(5), std::setfill('0'), 42, "]"));
+    // a value that does not change the format does not affect the following values
+    EXPECT_EQ(viaStream(UserType{}, 1.23456789), asString(UserType{}, 1.23456789));
+}
+
+TEST(Utilities, asStringLongStrings) {
+    const std::string longString(1000, 'x');
+    EXPECT_EQ("a" + longString + "1" + longString, rosinterface_handler::asString("a", longString, 1, longString));
+}
+
+TEST(Utilities, streamedContainers) {
+    const std::vector<int> vector{1, 2};
+    const std::array<double, 2> array{0.5, 1.5};
+    const std::map<std::string, int> map{{"a", 1}};
+    const rosinterface_handler::FlatMap<std::string, int> flatMap{{"b", 2}};
+    std::ostringstream oss;
+    oss << rosinterface_handler::streamed("vector ", vector, " array ", array, " map ", map, " flat map ", flatMap);
+    EXPECT_EQ(viaStream("vector ", vector, " array ", array, " map ", map, " flat map ", flatMap), oss.str());
+}
+
+TEST(Utilities, namespaceHelpers) {
+    using namespace rosinterface_handler;
+    EXPECT_EQ("node", nodeNameOf("/ns/node"));
+    EXPECT_EQ("node", nodeNameOf("node"));
+    EXPECT_EQ("", nodeNameOf("/ns/"));
+    EXPECT_EQ("/ns", parentNamespaceOf("/ns/node"));
+    EXPECT_EQ("", parentNamespaceOf("/node"));
+    EXPECT_EQ("node", parentNamespaceOf("node"));
+}
+
+TEST(Utilities, getTopicInterned) {
+    using namespace rosinterface_handler;
+    EXPECT_EQ(getTopic("/ns/", "topic"), getTopicInterned("/ns/", "topic"));
+    EXPECT_EQ(getTopic("/ns/", "/global"), getTopicInterned("/ns/", "/global"));
+    EXPECT_EQ(getTopic("/ns/", ""), getTopicInterned("/ns/", ""));
+    const std::string longTopic(300, 't');
+    EXPECT_EQ(getTopic("/ns/", longTopic), getTopicInterned("/ns/", longTopic));
+
+    // repeated calls return the same string
+    const auto& first = getTopicInterned("/ns/", "topic");
+    const auto numStrings = StringPool::instance().size();
+    EXPECT_EQ(&first, &getTopicInterned("/ns/", "topic"));
+    EXPECT_EQ(numStrings, StringPool::instance().size());
+}
+
+TEST(Utilities, clampVector) {
+    std::vector<double> values(1000, 1.);
+    values[10] = -5.;
+    values[500] = 7.;
+    values[999] = -1.;
+    rosinterface_handler::testMin<double>("values", values, 0.);
+    rosinterface_handler::testMax<double>("values", values, 2.);
+    EXPECT_DOUBLE_EQ(0., values[10]);
+    EXPECT_DOUBLE_EQ(2., values[500]);
+    EXPECT_DOUBLE_EQ(0., values[999]);
+    EXPECT_DOUBLE_EQ(1., values[11]);
+
+    std::vector<int> ints{-3, 0, 5, 10};
+    EXPECT_EQ(1, rosinterface_handler::detail::clampMin(ints.data(), ints.size(), 0));
+    EXPECT_EQ(2, rosinterface_handler::detail::clampMax(ints.data(), ints.size(), 4));
+    EXPECT_EQ(std::vector<int>({0, 0, 4, 4}), ints);
+}
+
+TEST(Utilities, flatMap) {
+    using rosinterface_handler::FlatMap;
+    FlatMap<std::string, int> map{{"c", 3}, {"a", 1}, {"b", 2}, {"a", 4}};
+    ASSERT_EQ(3, map.size());
+    EXPECT_EQ("a", map.begin()->first);
+    EXPECT_EQ(1, map.at("a"));
+    EXPECT_EQ(2, map.at(std::string_view("b")));
+    EXPECT_EQ(1, map.count(std::string("c")));
+    EXPECT_EQ(map.end(), map.find("d"));
+    EXPECT_THROW(map.at("d"), std::out_of_range); // NOLINT(cppcoreguidelines-avoid-goto)
+
+    map["d"] = 5;
+    EXPECT_FALSE(map.insert({"d", 6}).second);
+    EXPECT_EQ(5, map.at("d"));
+    EXPECT_EQ(1, map.erase("a"));
+    EXPECT_EQ((FlatMap<std::string, int>{{"b", 2}, {"c", 3}, {"d", 5}}), map);
+
+    EXPECT_EQ("c", map.erase(map.find("b"))->first);
+    EXPECT_EQ("d", map.erase(map.begin())->first);
+    EXPECT_EQ(map.end(), map.erase(map.cbegin()));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(Utilities, flatMapConstKeys) {
+    using Map = rosinterface_handler::FlatMap<std::string, int>;
+    Map map{{"a", 1}, {"b", 2}};
+    static_assert(std::is_same<decltype(map.begin()->first), const std::string&>::value, "Keys must be const");
+    static_assert(std::is_same<Map::value_type, std::pair<const std::string, int>>::value, "Like std::map");
+    for (auto&& elem : map) {
+        elem.second *= 10;
+    }
+    map.find("b")->second += 1;
+    Map::const_iterator it = map.begin();
+    EXPECT_EQ(10, it->second);
+    EXPECT_EQ(21, (it + 1)->second);
+    EXPECT_EQ(2, map.end() - it);
+    const std::map<std::string, int> stdMap(map.begin(), map.end());
+    EXPECT_EQ((std::map<std::string, int>{{"a", 10}, {"b", 21}}), stdMap);
+}
+
+TEST(Utilities, internedString) {
+    using rosinterface_handler::InternedString;
+    InternedString frameId{"base_link"};
+    const std::string other{"base_link"};
+    EXPECT_EQ(frameId, InternedString(other));
+    EXPECT_EQ(&frameId.str(), &InternedString(other).str());
+    EXPECT_EQ("base_link", frameId);
+    EXPECT_EQ(other, frameId);
+    EXPECT_NE(frameId, InternedString("odom"));
+    EXPECT_NE("odom", frameId);
+    EXPECT_TRUE(InternedString().empty());
+
+    const std::string& str = frameId;
+    EXPECT_EQ(other, str);
+    std::stringstream ss;
+    ss << frameId;
+    EXPECT_EQ(other, ss.str());
+    EXPECT_TRUE(InternedString("a") < InternedString("b"));
+    EXPECT_FALSE(frameId < InternedString(other));
+}
+
+TEST(Utilities, serialization) {
+    using rosinterface_handler::BinaryReader;
+    rosinterface_handler::SerializationBuffer buffer;
+    rosinterface_handler::serialize(buffer, int32_t{0x01020304});
+    EXPECT_EQ((rosinterface_handler::SerializationBuffer{4, 3, 2, 1}), buffer);
+
+    const std::vector<bool> bools{true, false};
+    const std::map<std::string, double> map{{"a", 1.5}, {"b", -2.}};
+    const rosinterface_handler::FlatMap<std::string, int> flatMap{{"c", 3}};
+    const std::array<int64_t, 2> array{-1, std::numeric_limits<int64_t>::max()};
+    rosinterface_handler::serialize(buffer, 1.1);
+    rosinterface_handler::serialize(buffer, std::string("Hello"));
+    rosinterface_handler::serialize(buffer, rosinterface_handler::InternedString("base_link"));
+    rosinterface_handler::serialize(buffer, bools);
+    rosinterface_handler::serialize(buffer, std::vector<std::string>{"Hello", "World"});
+    rosinterface_handler::serialize(buffer, map);
+    rosinterface_handler::serialize(buffer, flatMap);
+    rosinterface_handler::serialize(buffer, array);
+
+    BinaryReader reader(buffer);
+    int32_t i{0};
+    double d{0.};
+    std::string str;
+    rosinterface_handler::InternedString interned;
+    std::vector<bool> bools2;
+    std::vector<std::string> strings;
+    std::map<std::string, double> map2;
+    rosinterface_handler::FlatMap<std::string, int> flatMap2;
+    std::array<int64_t, 2> array2{};
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, i));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, d));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, str));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, interned));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, bools2));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, strings));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, map2));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, flatMap2));
+    ASSERT_TRUE(rosinterface_handler::deserialize(reader, array2));
+    EXPECT_TRUE(reader.empty());
+    EXPECT_EQ(0x01020304, i);
+    EXPECT_EQ(1.1, d);
+    EXPECT_EQ("Hello", str);
+    EXPECT_EQ("base_link", interned);
+    EXPECT_EQ(bools, bools2);
+    EXPECT_EQ((std::vector<std::string>{"Hello", "World"}), strings);
+    EXPECT_EQ(map, map2);
+    EXPECT_EQ(flatMap, flatMap2);
+    EXPECT_EQ(array, array2);
+
+    // data that ends early or claims more elements than it has
+    BinaryReader truncated(buffer.data(), 6);
+    EXPECT_TRUE(rosinterface_handler::deserialize(truncated, i));
+    EXPECT_FALSE(rosinterface_handler::deserialize(truncated, d));
+    const rosinterface_handler::SerializationBuffer hugeSize{0xff, 0xff, 0xff, 0xff, 1};
+    BinaryReader huge(hugeSize);
+    EXPECT_FALSE(rosinterface_handler::deserialize(huge, strings));
+}
+
+TEST(Utilities, json) {
+    auto toJson = [](const auto& val) {
+        rosinterface_handler::StringBuilder out;
+        rosinterface_handler::appendJson(out, val);
+        return std::move(out).str();
+    };
+    EXPECT_EQ("true", toJson(true));
+    EXPECT_EQ("-5", toJson(int8_t{-5}));
+    EXPECT_EQ("9223372036854775807", toJson(std::numeric_limits<int64_t>::max()));
+    EXPECT_EQ("0.1", toJson(0.1));
+    EXPECT_EQ(1. / 3., std::stod(toJson(1. / 3.)));
+    EXPECT_EQ("null", toJson(NAN));
+    EXPECT_EQ(R"("say \"hi\"\\\n\u0001")", toJson(std::string("say \"hi\"\\\n\x01")));
+    EXPECT_EQ(R"("base_link")", toJson(rosinterface_handler::InternedString("base_link")));
+    EXPECT_EQ("[true,false]", toJson(std::vector<bool>{true, false}));
+    EXPECT_EQ("[]", toJson(std::vector<int>{}));
+    const std::map<std::string, std::vector<double>> map{{"a", {}}, {"b", {1.5, -2.}}};
+    EXPECT_EQ(R"({"a":[],"b":[1.5,-2]})", toJson(map));
+    EXPECT_EQ(R"({"c":3})", toJson(rosinterface_handler::FlatMap<std::string, int>{{"c", 3}}));
+    EXPECT_EQ("[-1,2]", toJson(std::array<int, 2>{-1, 2}));
+}